@@ -0,0 +1,186 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <suborbital/Suborbital.hpp>
+#include <suborbital/scene/SceneStack.hpp>
+
+using namespace suborbital;
+
+/**
+ * Number of iterations for each benchmark.
+ */
+static const std::size_t iterations = 100000;
+
+/**
+ * A primitive attribute used for benchmarking purposes.
+ */
+class BenchmarkAttribute : public Attribute
+{
+public:
+    void create()
+    {
+        // Nothing to do.
+    }
+};
+
+TYPE(BenchmarkAttribute);
+
+/**
+ * A primitive event used for benchmarking purposes.
+ */
+class BenchmarkEvent : public Event
+{
+    // Nothing to do.
+};
+
+TYPE(BenchmarkEvent);
+
+/**
+ * Times the supplied function and prints the mean time taken per iteration.
+ *
+ * @param name Name of the benchmark.
+ * @param function Function that performs all of the iterations.
+ */
+template<typename Function>
+void measure(const std::string& name, Function function)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    function();
+    auto finish = std::chrono::high_resolution_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(finish - start).count();
+    std::cout << name << ": " << nanoseconds / iterations << " ns per iteration" << std::endl;
+}
+
+/**
+ * Scene that runs the benchmarks when it is created.
+ */
+class BenchmarkScene : public Scene
+{
+public:
+    void create()
+    {
+        // The containers are not reserved up front, so that the cost of relocating their contents as they grow is
+        // included in the measurements.
+        std::vector<WatchPtr<Entity>> created;
+        measure("EntityManager::create", [&]()
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                created.push_back(create_entity());
+            }
+        });
+
+        for (const WatchPtr<Entity>& entity : created)
+        {
+            entity->create_attribute<BenchmarkAttribute>();
+        }
+
+        std::vector<WatchPtr<BenchmarkAttribute>> attributes;
+        measure("Entity::attribute", [&]()
+        {
+            for (const WatchPtr<Entity>& entity : created)
+            {
+                attributes.push_back(entity->attribute<BenchmarkAttribute>());
+            }
+        });
+
+        // Transfer watch pointers from one container to another, releasing the originals as they go.
+        std::vector<WatchPtr<Entity>> transferred;
+        measure("WatchPtr transfer", [&]()
+        {
+            for (WatchPtr<Entity>& entity : created)
+            {
+                transferred.push_back(std::move(entity));
+            }
+
+            created.clear();
+        });
+
+        measure("WatchPtr swap", [&]()
+        {
+            using std::swap;
+            for (std::size_t i = 1; i < iterations; ++i)
+            {
+                swap(transferred[i - 1], transferred[i]);
+            }
+        });
+
+        std::vector<std::shared_ptr<BenchmarkEvent>> events;
+        measure("make_event", [&]()
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                events.push_back(make_event<BenchmarkEvent>());
+            }
+
+            events.clear();
+        });
+
+        // Each publish reaches 16 subscribers.
+        EventDispatcher dispatcher;
+        std::size_t received = 0;
+        std::vector<std::unique_ptr<EventSubscription>> subscriptions;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            subscriptions.push_back(dispatcher.subscribe<BenchmarkEvent>([&](std::shared_ptr<BenchmarkEvent> event)
+            {
+                ++received;
+            }));
+        }
+
+        std::shared_ptr<BenchmarkEvent> event = make_event<BenchmarkEvent>();
+        measure("EventDispatcher::publish", [&]()
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                dispatcher.publish(event);
+            }
+        });
+
+        // Only 3 of the entities subscribe for the broadcast event.
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            subscriptions.push_back(transferred[i]->subscribe<BenchmarkEvent>([&](std::shared_ptr<BenchmarkEvent> event)
+            {
+                ++received;
+            }));
+        }
+
+        measure("Scene::broadcast", [&]()
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                broadcast(event);
+            }
+        });
+    }
+
+    void update(double dt)
+    {
+        // Nothing to do.
+    }
+
+    void suspend()
+    {
+        // Nothing to do.
+    }
+
+    void resume()
+    {
+        // Nothing to do.
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    SceneStack scene_stack;
+    scene_stack.register_scene<BenchmarkScene>("BenchmarkScene");
+    scene_stack.push("BenchmarkScene");
+
+    return 0;
+}
\ No newline at end of file
@@ -21,5 +21,4 @@ class AttackRandomEnemyBehaviour(PythonBehaviour):
                 target.attribute(HealthAttribute).decrease(damage_to_inflict)
 
     def random_element_from_set(self, set):
-        iterator = set.begin + random.randint(0, set.size - 1)
-        return iterator.value()
\ No newline at end of file
+        return random.choice(list(set))
\ No newline at end of file
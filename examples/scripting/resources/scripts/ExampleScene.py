@@ -31,7 +31,7 @@ class ExampleScene(PythonScene):
             "neutralized", "liquidated", "murdered", "executed", "assassinated", "eradicated", "eliminated"]))
         entities = self.entities.all
         if entities.size <= 1:
-            victor = entities.begin.value()
+            victor = next(iter(entities))
             print("-----------------------------------")
             print(victor.name + " was victorious!")
             print("-----------------------------------")
\ No newline at end of file
@@ -0,0 +1,243 @@
+#ifndef SUBORBITAL_ARCHETYPE_HPP
+#define SUBORBITAL_ARCHETYPE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+#include <suborbital/NonCopyable.hpp>
+
+#include <suborbital/component/ComponentRegistry.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class Entity;
+    class Component;
+
+    /**
+     * Contiguous storage for all of the entities that have exactly the same set of component types attached.
+     *
+     * Components are stored as a structure of arrays. Each component type in the archetype's signature has its own
+     * column and the entity at a given row owns the component at that same row of every column. Entities that have
+     * several components of the same type attached simply have several columns for that type.
+     *
+     * The entity at each row is kept informed of its location in the storage, so that looking up a component only
+     * requires finding the column for the component type.
+     */
+    class Archetype : private NonCopyable
+    {
+    public:
+        /**
+         * Sorted list of the component types stored by an archetype (duplicates allowed).
+         */
+        typedef std::vector<ComponentTypeId> Signature;
+
+        /**
+         * Value returned by `column` in the event that the archetype does not store the requested component type.
+         */
+        static const std::size_t npos;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param signature Sorted list of the component types to be stored.
+         * @param behaviour_columns Indices of the columns that store behaviours.
+         */
+        Archetype(const Signature& signature, const std::vector<std::size_t>& behaviour_columns);
+
+        /**
+         * Destructor.
+         */
+        ~Archetype();
+
+        /**
+         * Accessor for the component types stored by the archetype.
+         *
+         * @return Sorted list of the component types stored by the archetype.
+         */
+        const Signature& signature() const;
+
+        /**
+         * Accessor for the number of rows in the archetype.
+         *
+         * @note This count includes rows that have been vacated but not yet compacted.
+         *
+         * @return Number of rows.
+         */
+        std::size_t size() const;
+
+        /**
+         * Checks whether the archetype stores every component type in the specified `types`.
+         *
+         * @param types Sorted list of component types.
+         * @return True if all of the component types are stored by the archetype, false otherwise.
+         */
+        bool includes(const Signature& types) const;
+
+        /**
+         * Finds the first column that stores components of the specified `type`.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param type Component type to search for.
+         * @return Index of the first column storing the component type, or `npos` if there is no such column.
+         */
+        std::size_t column(ComponentTypeId type) const;
+
+        /**
+         * Accessor for the entity at the specified `row`.
+         *
+         * @param row Row index.
+         * @return Pointer to the entity at the row, or a nullptr if the row has been vacated by a deleted entity.
+         */
+        Entity* entity(std::size_t row) const;
+
+        /**
+         * Stores the entity at the specified `row`.
+         *
+         * @param row Row index.
+         * @param entity Pointer to the entity to store.
+         */
+        void entity(std::size_t row, Entity* entity);
+
+        /**
+         * Accessor for the component at the specified `column` and `row`.
+         *
+         * @param column Column index.
+         * @param row Row index.
+         * @return Pointer to the component.
+         */
+        Component* component(std::size_t column, std::size_t row) const;
+
+        /**
+         * Stores a component at the specified `column` and `row`.
+         *
+         * @note The archetype does not take ownership of the component.
+         *
+         * @param column Column index.
+         * @param row Row index.
+         * @param component Pointer to the component to store.
+         */
+        void component(std::size_t column, std::size_t row, Component* component);
+
+        /**
+         * Accessor for the cached archetype that is reached by adding a component of the specified `type`.
+         *
+         * @param type Component type being added.
+         * @return Pointer to the destination archetype, or a nullptr if the transition has not been cached.
+         */
+        Archetype* next(ComponentTypeId type) const;
+
+        /**
+         * Caches the archetype that is reached by adding a component of the specified `type`.
+         *
+         * @param type Component type being added.
+         * @param archetype Pointer to the destination archetype.
+         */
+        void next(ComponentTypeId type, Archetype* archetype);
+
+        /**
+         * Appends a row for the specified `entity`.
+         *
+         * The components for the new row are initialised to nullptr's and must be stored by the caller.
+         *
+         * @param entity Pointer to the entity to append.
+         * @return Index of the row that was appended.
+         */
+        std::size_t insert(Entity* entity);
+
+        /**
+         * Removes the specified `row`, moving the last row into its place.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param row Index of the row to remove.
+         */
+        void remove(std::size_t row);
+
+        /**
+         * Marks the specified `row` for removal on the next call to `compact`.
+         *
+         * Vacating rows does not move any other rows, which makes it safe to do whilst the archetype is being updated.
+         *
+         * @param row Index of the row to vacate.
+         */
+        void vacate(std::size_t row);
+
+        /**
+         * Removes all vacated rows.
+         */
+        void compact();
+
+        /**
+         * Records the current number of rows.
+         *
+         * Rows appended after the snapshot has been taken (by entities that are created, or that have components
+         * attached, whilst the component storage is locked) are not visited when iterating.
+         */
+        void snapshot();
+
+        /**
+         * Accessor for the number of rows recorded by the last call to `snapshot`.
+         *
+         * @return Number of rows at the time of the snapshot, or zero if no snapshot has been taken.
+         */
+        std::size_t snapshot_size() const;
+
+        /**
+         * Updates the behaviours belonging to the alive entities in the first `rows` rows of the archetype.
+         *
+         * @param dt Time elapsed (in seconds) since the previous call to update.
+         * @param rows Number of rows to update.
+         */
+        void update(double dt, std::size_t rows);
+
+    private:
+        /**
+         * Component types stored by the archetype.
+         */
+        const Signature m_signature;
+
+        /**
+         * Indices of the columns that store behaviours.
+         */
+        const std::vector<std::size_t> m_behaviour_columns;
+
+        /**
+         * Index of the first column for each component type, indexed by component type identifier.
+         *
+         * Types that are not stored by the archetype map to `npos`. The table only extends as far as the largest
+         * identifier in the signature.
+         */
+        std::vector<std::size_t> m_column_lookup;
+
+        /**
+         * The entity at each row.
+         */
+        std::vector<Entity*> m_entities;
+
+        /**
+         * Component columns, one per entry in the signature.
+         */
+        std::vector<std::vector<Component*>> m_columns;
+
+        /**
+         * Rows that have been vacated but not yet removed.
+         */
+        std::vector<std::size_t> m_vacated;
+
+        /**
+         * Number of rows at the time of the last snapshot.
+         */
+        std::size_t m_snapshot_size;
+
+        /**
+         * Cached transitions to the archetypes reached by adding a component of a given type.
+         */
+        std::unordered_map<ComponentTypeId, Archetype*> m_next;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,306 @@
+#ifndef SUBORBITAL_ATOMIC_WATCHPTR_HPP
+#define SUBORBITAL_ATOMIC_WATCHPTR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include <suborbital/NonCopyable.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class Watchable;
+    class AtomicWatchPtrBase;
+
+    /**
+     * Shared record of whether the destruction of a watchable object has reached `~Watchable`.
+     *
+     * A token is created by a watchable object the first time that an `AtomicWatchPtr` watches it, and is shared by
+     * the object and all of its atomic watchers. The token is reference counted, so that it outlives the object for as
+     * long as any atomic watcher refers to it.
+     */
+    class WatchToken : private NonCopyable
+    {
+    friend Watchable;
+    friend AtomicWatchPtrBase;
+    private:
+        /**
+         * Constructor.
+         *
+         * The token is initially referenced only by the watchable object.
+         *
+         * @param object The watchable object.
+         */
+        WatchToken(const Watchable* object);
+
+        /**
+         * Adds a reference to the token.
+         */
+        void acquire();
+
+        /**
+         * Removes a reference to the token, deleting the token if no references remain.
+         */
+        void release();
+
+    private:
+        /**
+         * The watchable object, or a nullptr once the object has been deleted.
+         */
+        std::atomic<const Watchable*> m_object;
+
+        /**
+         * Number of references to the token, including the reference held by the watchable object.
+         */
+        std::atomic<std::size_t> m_references;
+    };
+
+    /**
+     * Base class for the template `AtomicWatchPtr` class.
+     */
+    class AtomicWatchPtrBase
+    {
+    protected:
+        /**
+         * Constructor.
+         */
+        AtomicWatchPtrBase();
+
+        /**
+         * Destructor.
+         */
+        ~AtomicWatchPtrBase() = default;
+
+        /**
+         * Starts watching the supplied watchable object.
+         */
+        void watch(const Watchable* watchable_object);
+
+        /**
+         * Starts watching the object watched by the `other` atomic watcher.
+         */
+        void share(const AtomicWatchPtrBase& other);
+
+        /**
+         * Takes over the token referred to by the `other` atomic watcher, leaving the `other` watcher empty.
+         */
+        void transfer(AtomicWatchPtrBase& other) noexcept;
+
+        /**
+         * Stops watching any object.
+         */
+        void unwatch();
+
+        /**
+         * Accessor for the object being watched.
+         *
+         * @return Pointer to the object being watched, or a nullptr if the object has been deleted.
+         */
+        const Watchable* watched() const;
+
+    private:
+        /**
+         * Token for the object being watched, or a nullptr if no object is being watched.
+         */
+        WatchToken* m_token;
+    };
+
+    /**
+     * Thread-safe liveness check for a watchable object.
+     *
+     * Like `WatchPtr`, an atomic watch pointer becomes NULL when the object that it watches is deleted. Unlike
+     * `WatchPtr`, distinct atomic watch pointers to the same object may be created, copied, destroyed and checked
+     * concurrently from any thread, and concurrently with the object being deleted. Watching an object for the first
+     * time allocates a shared token; subsequent copies only adjust the token's reference count, which is lock-free on
+     * all common platforms.
+     *
+     * An atomic watch pointer does not keep the object alive. The object is only marked as deleted once its
+     * destruction reaches `~Watchable`, after the destructors of the derived classes have run, and it may be deleted
+     * immediately after a check has succeeded. A successful check therefore does not make the object safe to use:
+     * dereferencing the pointer returned by `unsynchronised_get` requires external synchronisation with the thread
+     * that owns the object, such that the object cannot be deleted whilst it is being used.
+     *
+     * @note As with `std::shared_ptr`, a single atomic watch pointer must not be modified by one thread whilst another
+     * thread accesses it.
+     */
+    template<typename T>
+    class AtomicWatchPtr : public AtomicWatchPtrBase
+    {
+    template<typename U> friend class AtomicWatchPtr;
+    public:
+        /**
+         * Constructor.
+         */
+        AtomicWatchPtr() = default;
+
+        /**
+         * Constructor.
+         */
+        AtomicWatchPtr(std::nullptr_t) {};
+
+        /**
+         * Constructor.
+         */
+        explicit AtomicWatchPtr(T* t)
+        {
+            watch(t);
+        }
+
+        /**
+         * Copy constructor.
+         */
+        AtomicWatchPtr(const AtomicWatchPtr& t)
+        {
+            share(t);
+        }
+
+        /**
+         * Copy constructor.
+         */
+        template<typename U>
+        AtomicWatchPtr(const AtomicWatchPtr<U>& t)
+        {
+            share(t);
+        }
+
+        /**
+         * Move constructor.
+         */
+        AtomicWatchPtr(AtomicWatchPtr&& t) noexcept
+        {
+            transfer(t);
+        }
+
+        /**
+         * Move constructor.
+         */
+        template<typename U>
+        AtomicWatchPtr(AtomicWatchPtr<U>&& t) noexcept
+        {
+            transfer(t);
+        }
+
+        /**
+         * Destructor.
+         */
+        ~AtomicWatchPtr()
+        {
+            unwatch();
+        }
+
+        /**
+         * Copy assignment operator.
+         *
+         * @param t Pointer to the object to watch.
+         * @return Reference to this AtomicWatchPtr.
+         */
+        AtomicWatchPtr& operator=(T* t)
+        {
+            watch(t);
+            return *this;
+        }
+
+        /**
+         * Copy assignment operator.
+         *
+         * @param other Other AtomicWatchPtr to copy from.
+         * @return Reference to this AtomicWatchPtr.
+         */
+        AtomicWatchPtr& operator=(const AtomicWatchPtr& other)
+        {
+            share(other);
+            return *this;
+        }
+
+        /**
+         * Move assignment operator.
+         *
+         * @param other Other AtomicWatchPtr to move from.
+         * @return Reference to this AtomicWatchPtr.
+         */
+        AtomicWatchPtr& operator=(AtomicWatchPtr&& other) noexcept
+        {
+            if (this != &other)
+            {
+                transfer(other);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Equality operator.
+         *
+         * @param other The other AtomicWatchPtr to compare with.
+         * @return True if the two AtomicWatchPtr's are watching the same object, false otherwise.
+         */
+        bool operator==(const AtomicWatchPtr& other) const
+        {
+            return watched() == other.watched();
+        }
+
+        /**
+         * Boolean conversion operator.
+         *
+         * @return True if the watched object has not yet been deleted, false otherwise.
+         */
+        explicit operator bool() const
+        {
+            return watched() != nullptr;
+        }
+
+        /**
+         * Checks whether the watched object has been deleted, or no object is being watched.
+         *
+         * The result may be out of date as soon as it is returned, unless the caller is synchronised with the thread
+         * that owns the object.
+         *
+         * @return True if no object is being watched, false otherwise.
+         */
+        bool expired() const
+        {
+            return watched() == nullptr;
+        }
+
+        /**
+         * Accessor for the object being watched.
+         *
+         * The object is not pinned by this call. The returned pointer may only be dereferenced whilst the caller is
+         * synchronised with the thread that owns the object, for example during a phase in which that thread does not
+         * delete objects.
+         *
+         * @return Pointer to the object being watched, or a nullptr if the object has been deleted.
+         */
+        T* unsynchronised_get() const
+        {
+            return (T*)watched();
+        }
+
+        /**
+         * Exchanges the objects watched by this AtomicWatchPtr and the `other` AtomicWatchPtr.
+         *
+         * @param other The other AtomicWatchPtr.
+         */
+        void swap(AtomicWatchPtr& other) noexcept
+        {
+            AtomicWatchPtr temporary(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temporary);
+        }
+    };
+
+    /**
+     * Exchanges the objects watched by `a` and `b`.
+     *
+     * @param a The first AtomicWatchPtr.
+     * @param b The second AtomicWatchPtr.
+     */
+    template<typename T>
+    void swap(AtomicWatchPtr<T>& a, AtomicWatchPtr<T>& b) noexcept
+    {
+        a.swap(b);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#ifndef SUBORBITAL_BITSET_HPP
+#define SUBORBITAL_BITSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace suborbital
+{
+    /**
+     * Dynamically sized set of bits.
+     *
+     * The set grows as bits are set, so that any bit index may be used. Bits beyond the current size are considered
+     * to be unset.
+     */
+    class Bitset
+    {
+    public:
+        /**
+         * Value returned by `first` and `next` when there are no further set bits.
+         */
+        static const std::size_t npos;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * All bits are initially unset.
+         */
+        Bitset();
+
+        /**
+         * Destructor.
+         */
+        ~Bitset();
+
+        /**
+         * Checks whether the specified `bit` is set.
+         *
+         * @param bit Index of the bit.
+         * @return True if the bit is set, false otherwise.
+         */
+        bool test(std::size_t bit) const;
+
+        /**
+         * Sets the specified `bit`.
+         *
+         * @param bit Index of the bit.
+         */
+        void set(std::size_t bit);
+
+        /**
+         * Unsets the specified `bit`.
+         *
+         * @param bit Index of the bit.
+         */
+        void reset(std::size_t bit);
+
+        /**
+         * Unsets all of the bits.
+         */
+        void clear();
+
+        /**
+         * Checks whether no bits are set.
+         *
+         * @return True if no bits are set, false otherwise.
+         */
+        bool none() const;
+
+        /**
+         * Counts the set bits.
+         *
+         * @return Number of set bits.
+         */
+        std::size_t count() const;
+
+        /**
+         * Checks whether all of the bits that are set in the `other` bitset are also set in this bitset.
+         *
+         * @param other The other bitset.
+         * @return True if this bitset is a superset of the `other` bitset, false otherwise.
+         */
+        bool includes(const Bitset& other) const;
+
+        /**
+         * Checks whether any bit is set in both this bitset and the `other` bitset.
+         *
+         * @param other The other bitset.
+         * @return True if the bitsets have a set bit in common, false otherwise.
+         */
+        bool intersects(const Bitset& other) const;
+
+        /**
+         * Returns the index of the lowest set bit.
+         *
+         * @return Index of the lowest set bit, or `npos` if no bits are set.
+         */
+        std::size_t first() const;
+
+        /**
+         * Returns the index of the lowest set bit after the specified `bit`.
+         *
+         * @param bit Index of the bit to search after.
+         * @return Index of the next set bit, or `npos` if there are no further set bits.
+         */
+        std::size_t next(std::size_t bit) const;
+
+        /**
+         * Bitwise and assignment operator.
+         *
+         * @param other The other bitset.
+         * @return Reference to this bitset, having unset any bits that are not set in the `other` bitset.
+         */
+        Bitset& operator&=(const Bitset& other);
+
+        /**
+         * Bitwise or assignment operator.
+         *
+         * @param other The other bitset.
+         * @return Reference to this bitset, having set any bits that are set in the `other` bitset.
+         */
+        Bitset& operator|=(const Bitset& other);
+
+        /**
+         * Equality operator.
+         *
+         * @param other The other bitset to compare with.
+         * @return True if the same bits are set in both bitsets, false otherwise.
+         */
+        bool operator==(const Bitset& other) const;
+
+        /**
+         * Inequality operator.
+         *
+         * @param other The other bitset to compare with.
+         * @return True if the bitsets differ, false otherwise.
+         */
+        bool operator!=(const Bitset& other) const;
+
+    private:
+        /**
+         * Returns the index of the lowest set bit at or after the specified `bit`.
+         *
+         * @param bit Index of the bit to start searching from.
+         * @return Index of the set bit, or `npos` if there are no further set bits.
+         */
+        std::size_t search(std::size_t bit) const;
+
+    private:
+        /**
+         * Words holding the bits, least significant bit first.
+         */
+        std::vector<std::uint64_t> m_words;
+    };
+}
+
+#endif
\ No newline at end of file
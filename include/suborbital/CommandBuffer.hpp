@@ -0,0 +1,301 @@
+#ifndef SUBORBITAL_COMMAND_BUFFER_HPP
+#define SUBORBITAL_COMMAND_BUFFER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <suborbital/NonCopyable.hpp>
+#include <suborbital/WatchPtr.hpp>
+#include <suborbital/EntityHandle.hpp>
+#include <suborbital/Entity.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class EntityManager;
+
+    /**
+     * Records structural changes to the entities in a scene so that they can be applied later in a single batch.
+     *
+     * Creating and destroying entities, creating and removing components and changing group membership are recorded
+     * rather than performed immediately. Recorded commands are applied by the `EntityManager` at the end of each call
+     * to `Scene::process` (after the entities have been updated and before destroyed entities are deleted), sorted by
+     * the entity that they target. Commands that target the same entity are applied in the order that they were
+     * recorded. Commands that target an entity that has since been deleted are discarded.
+     *
+     * A command buffer does not access the scene whilst recording. Any number of threads may therefore record
+     * commands concurrently, provided that each thread records into its own buffer, and hand the buffers over using
+     * `EntityManager::submit`.
+     */
+    class CommandBuffer : private NonCopyable
+    {
+    friend EntityManager;
+    public:
+        /**
+         * Entity targeted by a command.
+         *
+         * Targets either refer to an existing entity or to an entity whose creation was recorded in the same buffer.
+         */
+        class Target
+        {
+        friend CommandBuffer;
+        friend EntityManager;
+        public:
+            /**
+             * Constructor.
+             *
+             * @param handle Handle to an existing entity.
+             */
+            Target(EntityHandle handle);
+
+            /**
+             * Constructor.
+             *
+             * @param entity Pointer to an existing entity.
+             */
+            Target(const WatchPtr<Entity>& entity);
+
+        private:
+            /**
+             * Constructor.
+             *
+             * @param created Index of an entity whose creation was recorded.
+             */
+            explicit Target(std::size_t created);
+
+        private:
+            /**
+             * Handle to the targeted entity, if it already exists.
+             */
+            EntityHandle m_handle;
+
+            /**
+             * Index of the targeted entity amongst those created by the recorded commands, or `npos` if the entity
+             * already exists.
+             */
+            std::size_t m_created;
+        };
+
+    public:
+        /**
+         * Constructor.
+         */
+        CommandBuffer();
+
+        /**
+         * Destructor.
+         */
+        ~CommandBuffer();
+
+        /**
+         * Records the creation of an entity.
+         *
+         * Sets the entity's name to the empty string.
+         *
+         * @return Target referring to the entity to be created, for use with subsequent commands in this buffer.
+         */
+        Target create();
+
+        /**
+         * Records the creation of an entity.
+         *
+         * @param entity_name Name for the entity.
+         * @return Target referring to the entity to be created, for use with subsequent commands in this buffer.
+         */
+        Target create(const std::string& entity_name);
+
+        /**
+         * Records the destruction of the `target` entity.
+         *
+         * @param target Entity to destroy.
+         */
+        void destroy(Target target);
+
+        /**
+         * Records the creation of an attribute of the specified type on the `target` entity.
+         *
+         * @param target Entity to attach the attribute to.
+         */
+        template<typename AttributeType>
+        void create_attribute(Target target)
+        {
+            record(Operation::CreateAttribute, target, std::string(), &attribute_creator<AttributeType>);
+        }
+
+        /**
+         * Records the creation of an attribute of the type specified by `class_name` on the `target` entity.
+         *
+         * @param target Entity to attach the attribute to.
+         * @param class_name Class name for the attribute.
+         */
+        void create_attribute(Target target, const std::string& class_name);
+
+        /**
+         * Records the creation of a behaviour of the specified type on the `target` entity.
+         *
+         * @param target Entity to attach the behaviour to.
+         */
+        template<typename BehaviourType>
+        void create_behaviour(Target target)
+        {
+            record(Operation::CreateBehaviour, target, std::string(), &behaviour_creator<BehaviourType>);
+        }
+
+        /**
+         * Records the creation of a behaviour of the type specified by `class_name` on the `target` entity.
+         *
+         * @param target Entity to attach the behaviour to.
+         * @param class_name Class name for the behaviour.
+         */
+        void create_behaviour(Target target, const std::string& class_name);
+
+        /**
+         * Records the removal of a component of the specified type from the `target` entity. If multiple components
+         * of the type are attached then the first such component is removed.
+         *
+         * @param target Entity to remove the component from.
+         */
+        template<typename ComponentType>
+        void remove_component(Target target)
+        {
+            remove_component(target, Type<ComponentType>::name());
+        }
+
+        /**
+         * Records the removal of a component of the type specified by `class_name` from the `target` entity. If
+         * multiple components of the type are attached then the first such component is removed.
+         *
+         * @param target Entity to remove the component from.
+         * @param class_name Class name for the component.
+         */
+        void remove_component(Target target, const std::string& class_name);
+
+        /**
+         * Records the addition of the `target` entity to the group denoted by the provided `group_name`.
+         *
+         * @param target Entity to add to the group.
+         * @param group_name Name of the group.
+         */
+        void add_to_group(Target target, const std::string& group_name);
+
+        /**
+         * Records the removal of the `target` entity from the group denoted by the provided `group_name`.
+         *
+         * @param target Entity to remove from the group.
+         * @param group_name Name of the group.
+         */
+        void remove_from_group(Target target, const std::string& group_name);
+
+        /**
+         * Accessor for the number of recorded commands.
+         *
+         * @return Number of commands.
+         */
+        std::size_t size() const;
+
+        /**
+         * Checks whether no commands have been recorded.
+         *
+         * @return True if the buffer holds no commands, false otherwise.
+         */
+        bool empty() const;
+
+        /**
+         * Discards all recorded commands.
+         */
+        void clear();
+
+    private:
+        /**
+         * Operations that can be recorded.
+         */
+        enum class Operation
+        {
+            Create,
+            Destroy,
+            CreateAttribute,
+            CreateBehaviour,
+            RemoveComponent,
+            AddToGroup,
+            RemoveFromGroup
+        };
+
+        /**
+         * Recorded command.
+         */
+        struct Command
+        {
+            /**
+             * Operation to perform.
+             */
+            Operation operation;
+
+            /**
+             * Entity to perform the operation on.
+             */
+            Target target;
+
+            /**
+             * Entity name, component class name or group name, depending on the operation.
+             */
+            std::string name;
+
+            /**
+             * Function that creates a component of a c++ type, or a nullptr if the component is created by name.
+             */
+            void (*creator)(Entity&);
+        };
+
+    private:
+        /**
+         * Appends a command to the buffer.
+         *
+         * @param operation Operation to perform.
+         * @param target Entity to perform the operation on.
+         * @param name Entity name, component class name or group name, depending on the operation.
+         * @param creator Function that creates a component of a c++ type.
+         */
+        void record(Operation operation, Target target, const std::string& name, void (*creator)(Entity&) = nullptr);
+
+        /**
+         * Creates an attribute of the templated type on the supplied `entity`.
+         *
+         * @param entity Entity to attach the attribute to.
+         */
+        template<typename AttributeType>
+        static void attribute_creator(Entity& entity)
+        {
+            entity.create_attribute<AttributeType>();
+        }
+
+        /**
+         * Creates a behaviour of the templated type on the supplied `entity`.
+         *
+         * @param entity Entity to attach the behaviour to.
+         */
+        template<typename BehaviourType>
+        static void behaviour_creator(Entity& entity)
+        {
+            entity.create_behaviour<BehaviourType>();
+        }
+
+    private:
+        /**
+         * Value of `Target::m_created` for targets that refer to existing entities.
+         */
+        static const std::size_t npos;
+
+        /**
+         * Recorded commands, in the order that they were recorded.
+         */
+        std::vector<Command> m_commands;
+
+        /**
+         * Number of entities whose creation has been recorded.
+         */
+        std::size_t m_created;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -4,15 +4,17 @@
 #include <cassert>
 #include <string>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 #include <iostream>
 
 #include <suborbital/NonCopyable.hpp>
+#include <suborbital/Bitset.hpp>
 #include <suborbital/Watchable.hpp>
 #include <suborbital/WatchPtr.hpp>
+#include <suborbital/EntityHandle.hpp>
 
 #include <suborbital/event/EventDispatcher.hpp>
+#include <suborbital/event/SubscriptionObserver.hpp>
 
 #include <suborbital/component/Attribute.hpp>
 #include <suborbital/component/Behaviour.hpp>
@@ -41,19 +43,35 @@ namespace suborbital
     // Forward declarations.
     class Scene;
     class System;
+    class EntityManager;
+    class Archetype;
+    class EntityQuery;
+    class EntityView;
+
+    /**
+     * Identifier for an interned entity name (see `EntityManager::name_id`).
+     */
+    typedef std::size_t EntityNameId;
 
     /**
      * Represents an object within a scene.
      */
-    class Entity : public Watchable, private NonCopyable
+    class Entity : public Watchable, private NonCopyable, private SubscriptionObserver
     {
     friend Scene;
+    friend EntityManager;
+    friend Archetype;
+    friend EntityQuery;
+    friend EntityView;
     public:
         /**
          * Constructor.
          *
          * Sets the entity's name to the empty string.
          *
+         * @note Entities are allocated from their scene's entity pool and should only be created through the scene
+         * (or through `create_child`).
+         *
          * @param scene Scene that the entity is in.
          */
         Entity(Scene& scene);
@@ -85,6 +103,16 @@ namespace suborbital
          */
         const std::string& name() const;
 
+        /**
+         * Accessor for the handle to the entity.
+         *
+         * Handles are a trivially copyable alternative to `WatchPtr<Entity>` that can be resolved back to the entity
+         * through the scene's `EntityManager`.
+         *
+         * @return Handle to the entity.
+         */
+        EntityHandle handle() const;
+
         /**
          * Checks whether the entity has been marked for destruction.
          *
@@ -100,7 +128,7 @@ namespace suborbital
         bool alive() const;
 
         /**
-         * Marks the entity for destruction.
+         * Marks the entity, along with all of its descendants, for destruction.
          *
          * @note The entity will be immediately removed from the scene. However, the entity is not deleted until after
          * all of the entities in the scene have been updated.
@@ -121,6 +149,14 @@ namespace suborbital
          */
         void remove_from_group(const std::string& group_name);
 
+        /**
+         * Checks whether the entity is a member of the group specified by the provided `group_name`.
+         *
+         * @param group_name Name of the group.
+         * @return True if the entity is a member of the group, false otherwise.
+         */
+        bool in_group(const std::string& group_name) const;
+
         /**
          * Checks whether the entity has any children.
          *
@@ -169,18 +205,8 @@ namespace suborbital
         template<typename AttributeType>
         bool has_attribute() const
         {
-            auto iter = m_attributes.find(Type<AttributeType>::name());
-            if (iter != m_attributes.end())
-            {
-                auto& attributes = iter->second;
-                if (!attributes.empty())
-                {
-                    AttributeType* attribute_ptr = dynamic_cast<AttributeType*>(attributes.front().get());
-                    return attribute_ptr != nullptr;
-                }
-            }
-
-            return false;
+            Component* component = find_component(Type<AttributeType>::id());
+            return dynamic_cast<AttributeType*>(component) != nullptr;
         }
 
         /**
@@ -203,8 +229,8 @@ namespace suborbital
         template<typename AttributeType>
         WatchPtr<AttributeType> create_attribute()
         {
-            AttributeType* attribute_ptr = new AttributeType();
-            m_attributes[Type<AttributeType>::name()].push_back(std::unique_ptr<AttributeType>(attribute_ptr));
+            AttributeType* attribute_ptr = component_registry().create_component<AttributeType>();
+            attach_component(Type<AttributeType>::id(), attribute_ptr, false);
 
             attribute_ptr->m_entity = this;
             attribute_ptr->create();
@@ -231,11 +257,10 @@ namespace suborbital
         template<typename AttributeType>
         WatchPtr<AttributeType> attribute()
         {
-            auto iter = m_behaviours.find(Type<AttributeType>::name());
-            assert(iter != m_behaviours.end());
-            assert(!iter->second.empty());
+            Component* component = find_component(Type<AttributeType>::id());
+            assert(component != nullptr);
 
-            AttributeType* attribute_ptr = dynamic_cast<AttributeType*>(iter->second.front().get());
+            AttributeType* attribute_ptr = dynamic_cast<AttributeType*>(component);
             assert(attribute_ptr != nullptr);
             return WatchPtr<AttributeType>(attribute_ptr);
         }
@@ -257,10 +282,8 @@ namespace suborbital
         template<typename BehaviourType>
         void create_behaviour()
         {
-            BehaviourType* specific_behaviour_ptr = new BehaviourType();
-            std::unique_ptr<BehaviourType> specific_behaviour(specific_behaviour_ptr);
-
-            m_behaviours[Type<BehaviourType>::name()].push_back(std::move(specific_behaviour));
+            BehaviourType* specific_behaviour_ptr = component_registry().create_component<BehaviourType>();
+            attach_component(Type<BehaviourType>::id(), specific_behaviour_ptr, true);
 
             specific_behaviour_ptr->m_entity = this;
             specific_behaviour_ptr->create();
@@ -285,11 +308,14 @@ namespace suborbital
          * @param event_name Name of the event to publish.
          * @param Shared pointer to the event to be published.
          */
-        void publish(const std::string& event_name, std::shared_ptr<suborbital::Event> event);
+        void publish(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event);
 
         /**
          * Broadcasts an event to all descendant entities (not including this entity).
          *
+         * Only the entities that have subscribers for the event are visited, and they receive the event in no
+         * particular order.
+         *
          * The event must be passed as a shared pointer to the event. This is because we make no assumption about how
          * subscribers may choose to use the event. For instance, we cannot guarantee that subscribers will not make
          * use of the event beyond the lifetime of their callback function.
@@ -297,11 +323,14 @@ namespace suborbital
          * @param event_name Name of the event to broadcast.
          * @param Shared pointer to the event to be broadcast.
          */
-        void broadcast_descendents(const std::string& event_name, std::shared_ptr<suborbital::Event> event);
+        void broadcast_descendents(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event);
 
         /**
          * Broadcasts an event to this entity and all descendant entities.
          *
+         * Only the entities that have subscribers for the event are visited, and they receive the event in no
+         * particular order.
+         *
          * The event must be passed as a shared pointer to the event. This is because we make no assumption about how
          * subscribers may choose to use the event. For instance, we cannot guarantee that subscribers will not make
          * use of the event beyond the lifetime of their callback function.
@@ -309,7 +338,7 @@ namespace suborbital
          * @param event_name Name of the event to broadcast.
          * @param Shared pointer to the event to be broadcast.
          */
-        void broadcast(const std::string& event_name, std::shared_ptr<suborbital::Event> event);
+        void broadcast(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event);
 
         /**
          * Subscribes to receive events of the specified `event_name`.
@@ -320,20 +349,142 @@ namespace suborbital
          *
          * @param event_name Name of the event to subscribe for.
          * @param callback Callback function that should receive the events.
+         * @param delivery When events should be delivered to the callback.
          * @return Subscription object that controls the lifetime of the subscription.
          */
         std::unique_ptr<suborbital::EventSubscription> subscribe(const std::string& event_name,
-                std::unique_ptr<suborbital::EventCallbackBase> callback);
+                std::unique_ptr<suborbital::EventCallbackBase> callback,
+                EventDelivery delivery = EventDelivery::Immediate);
+
+        /**
+         * Publishes an event to be dispatched to all subscribers of the event's type on this entity.
+         *
+         * The event type must have been declared using the `TYPE` macro. The event is delivered to subscribers without
+         * looking up the event name.
+         *
+         * @param Shared pointer to the event to be published.
+         */
+        template<typename EventType>
+        void publish(const std::shared_ptr<EventType>& event)
+        {
+            // Entities without a dispatcher have never had any subscribers.
+            if (m_event_dispatcher != nullptr)
+            {
+                m_event_dispatcher->publish(event);
+            }
+        }
+
+        /**
+         * Broadcasts an event to all descendant entities (not including this entity).
+         *
+         * @param Shared pointer to the event to be broadcast.
+         */
+        template<typename EventType>
+        void broadcast_descendents(const std::shared_ptr<EventType>& event)
+        {
+            broadcast_event(EventDispatcher::event_type<EventType>(), event, false);
+        }
+
+        /**
+         * Broadcasts an event to this entity and all descendant entities.
+         *
+         * @param Shared pointer to the event to be broadcast.
+         */
+        template<typename EventType>
+        void broadcast(const std::shared_ptr<EventType>& event)
+        {
+            broadcast_event(EventDispatcher::event_type<EventType>(), event, true);
+        }
+
+        /**
+         * Subscribes to receive events of the templated type.
+         *
+         * The event type must have been declared using the `TYPE` macro.
+         *
+         * @param callback_function Function that should receive the events.
+         * @param delivery When events should be delivered to the callback.
+         * @return Subscription object that controls the lifetime of the subscription.
+         */
+        template<typename EventType>
+        std::unique_ptr<suborbital::EventSubscription> subscribe(
+                const std::function<void(std::shared_ptr<EventType>)>& callback_function,
+                EventDelivery delivery = EventDelivery::Immediate)
+        {
+            return event_dispatcher().subscribe<EventType>(callback_function, delivery);
+        }
 
     private:
         /**
-         * Updates all the behaviours belonging to the entity.
+         * Publishes an event to all descendant entities and, optionally, to this entity.
+         *
+         * Only the entities in the scene that have subscribers for the event type are visited (see
+         * `EntityManager::subscribers`), so the cost does not depend on the number of descendants.
          *
-         * This function is called once per state update by the scene that the entity belongs to.
+         * @param event_type Identifier for the event type.
+         * @param event Shared pointer to the event to be broadcast.
+         * @param include_self Whether this entity should also receive the event.
+         */
+        void broadcast_event(EventTypeId event_type, const std::shared_ptr<suborbital::Event>& event,
+                bool include_self);
+
+        /**
+         * Checks whether this entity is a descendant of the specified `ancestor`.
          *
-         * @param dt Time elapsed (in seconds) since the previous call to update.
+         * @param ancestor Pointer to the potential ancestor.
+         * @return True if `ancestor` is the parent, or an ancestor of the parent, of this entity.
          */
-        void update(double dt);
+        bool descends_from(const Entity* ancestor) const;
+
+        /**
+         * Accessor for the entity's event dispatcher, creating the dispatcher if the entity does not yet have one.
+         *
+         * @return Reference to the event dispatcher.
+         */
+        EventDispatcher& event_dispatcher();
+
+        /**
+         * Adds the entity to the scene's index of entities that have subscribers for the specified event type.
+         *
+         * @param event_type Identifier for the event type.
+         */
+        void first_subscribed(EventTypeId event_type);
+
+        /**
+         * Removes the entity from the scene's index of entities that have subscribers for the specified event type.
+         *
+         * @param event_type Identifier for the event type.
+         */
+        void last_unsubscribed(EventTypeId event_type);
+
+        /**
+         * Attaches the supplied component to the entity by storing it in the scene's component storage.
+         *
+         * @note The component storage takes ownership of the component.
+         *
+         * @param type Identifier for the component type.
+         * @param component Pointer to the component to attach.
+         * @param behaviour Whether the component is a behaviour.
+         */
+        void attach_component(ComponentTypeId type, Component* component, bool behaviour);
+
+        /**
+         * Finds the first attached component with the specified type identifier.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param type Identifier for the component type.
+         * @return Pointer to the first such component, or a nullptr if no such component is attached.
+         */
+        Component* find_component(ComponentTypeId type) const;
+
+        /**
+         * Finds the first attached component with the specified `class_name`.
+         *
+         * @param class_name Class name for the component.
+         * @param behaviour Whether the component is a behaviour.
+         * @return Pointer to the first such component, or a nullptr if no such component is attached.
+         */
+        Component* find_component(const std::string& class_name, bool behaviour) const;
 
     private:
         /**
@@ -359,28 +510,46 @@ namespace suborbital
         /**
          * Child entities.
          */
-        std::vector<std::unique_ptr<Entity>> m_children;
+        std::vector<Entity*> m_children;
 
         /**
-         * Event dispatcher for the entity.
+         * Event dispatcher for the entity, or a nullptr if nothing has subscribed for events on the entity.
+         *
+         * Most entities never have subscribers, so the dispatcher is only created on the first subscription.
+         *
+         * @note The dispatcher is allocated from, and returned to, the entity manager's dispatcher pool.
          */
-        std::unique_ptr<EventDispatcher> m_event_dispatcher;
+        EventDispatcher* m_event_dispatcher;
 
         /**
-         * Attributes attached to the entity, indexed by class name.
-         *
-         * We store unique_ptr's here so that the attributes attached to an entity are automatically deleted when the
-         * entity is deleted.
+         * Handle to the entity, assigned by the entity manager.
          */
-        std::unordered_map<std::string, std::vector<std::unique_ptr<Attribute>>> m_attributes;
+        EntityHandle m_handle;
 
         /**
-         * Behaviours attached to the entity, indexed by class name.
-         *
-         * We store unique_ptr's here so that the behaviours attached to an entity are automatically deleted when the
-         * entity is deleted.
+         * Archetype that stores the components attached to the entity.
+         */
+        Archetype* m_archetype;
+
+        /**
+         * Row of the archetype that stores the components attached to the entity.
+         */
+        std::size_t m_row;
+
+        /**
+         * Identifiers for the groups that the entity is a member of.
+         */
+        Bitset m_groups;
+
+        /**
+         * Identifier for the entity's name, or `EntityManager::no_name` if the entity is unnamed.
+         */
+        EntityNameId m_name_id;
+
+        /**
+         * Position of the entity amongst the entities sharing its name.
          */
-        std::unordered_map<std::string, std::vector<std::unique_ptr<Behaviour>>> m_behaviours;
+        std::size_t m_name_slot;
     };
 }
 
@@ -0,0 +1,150 @@
+#ifndef SUBORBITAL_ENTITY_HANDLE_HPP
+#define SUBORBITAL_ENTITY_HANDLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace suborbital
+{
+    /**
+     * Lightweight reference to an entity.
+     *
+     * A handle consists of the index of the slot that the entity occupies in its scene's `EntityManager` and the
+     * generation of that slot. Slots are reused once their entities are deleted, but the generation is incremented
+     * each time, so a handle to a deleted entity is detected by a generation mismatch when it is resolved through
+     * `EntityManager::get`.
+     *
+     * Unlike `WatchPtr<Entity>`, handles are trivially copyable: copying or destroying a handle does not register
+     * or unregister anything with the entity. Handles are only meaningful within the scene that issued them.
+     */
+    class EntityHandle
+    {
+    public:
+        /**
+         * Constructor.
+         *
+         * Constructs a null handle that does not refer to any entity.
+         */
+        EntityHandle()
+        : m_index(0)
+        , m_generation(0)
+        {
+            // Nothing to do.
+        }
+
+        /**
+         * Constructor.
+         *
+         * @param index Index of the entity's slot.
+         * @param generation Generation of the entity's slot.
+         */
+        EntityHandle(std::uint32_t index, std::uint32_t generation)
+        : m_index(index)
+        , m_generation(generation)
+        {
+            // Nothing to do.
+        }
+
+        /**
+         * Accessor for the index of the entity's slot.
+         *
+         * @return Slot index.
+         */
+        std::uint32_t index() const
+        {
+            return m_index;
+        }
+
+        /**
+         * Accessor for the generation of the entity's slot.
+         *
+         * @return Slot generation.
+         */
+        std::uint32_t generation() const
+        {
+            return m_generation;
+        }
+
+        /**
+         * Accessor for the handle packed into a single 64-bit value.
+         *
+         * @return Packed handle, with the generation in the upper 32 bits and the index in the lower 32 bits.
+         */
+        std::uint64_t value() const
+        {
+            return (static_cast<std::uint64_t>(m_generation) << 32) | m_index;
+        }
+
+        /**
+         * Equality operator.
+         *
+         * @param other The other handle to compare with.
+         * @return True if the two handles refer to the same entity, false otherwise.
+         */
+        bool operator==(const EntityHandle& other) const
+        {
+            return m_index == other.m_index && m_generation == other.m_generation;
+        }
+
+        /**
+         * Inequality operator.
+         *
+         * @param other The other handle to compare with.
+         * @return True if the two handles refer to different entities, false otherwise.
+         */
+        bool operator!=(const EntityHandle& other) const
+        {
+            return !(*this == other);
+        }
+
+        /**
+         * Less-than comparison operator.
+         *
+         * @param other The other handle to compare with.
+         * @return True if the packed value of this handle is less than that of `other`, false otherwise.
+         */
+        bool operator<(const EntityHandle& other) const
+        {
+            return value() < other.value();
+        }
+
+        /**
+         * Boolean conversion operator.
+         *
+         * @note A non-null handle may still refer to an entity that has since been deleted. Use
+         * `EntityManager::valid` to check whether the entity still exists.
+         *
+         * @return True if the handle is not null, false otherwise.
+         */
+        explicit operator bool() const
+        {
+            return m_generation != 0;
+        }
+
+    private:
+        /**
+         * Index of the entity's slot.
+         */
+        std::uint32_t m_index;
+
+        /**
+         * Generation of the entity's slot. Zero is reserved for null handles.
+         */
+        std::uint32_t m_generation;
+    };
+}
+
+namespace std
+{
+    template<>
+    struct hash<suborbital::EntityHandle>
+    {
+        std::size_t operator()(const suborbital::EntityHandle& handle) const
+        {
+            return std::hash<std::uint64_t>()(handle.value());
+        }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -2,23 +2,47 @@
 #define SUBORBITAL_ENTITY_MANAGER_HPP
 
 #include <string>
-#include <set>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include <suborbital/NonCopyable.hpp>
+#include <suborbital/ObjectPool.hpp>
 #include <suborbital/WatchPtr.hpp>
 #include <suborbital/EntitySet.hpp>
+#include <suborbital/EntityView.hpp>
+#include <suborbital/EntityQuery.hpp>
+#include <suborbital/CommandBuffer.hpp>
+#include <suborbital/EntityHandle.hpp>
+#include <suborbital/Archetype.hpp>
 
 namespace suborbital
 {
     class Scene;
     class Entity;
+    class Component;
+    class EventDispatcher;
+    class SubscriptionObserver;
 
+    /**
+     * Manages the entities in a scene along with the storage for their components.
+     *
+     * Components are stored by archetype. All of the entities (including child entities) that have exactly the same
+     * set of component types attached share an `Archetype`, which stores their components contiguously by type.
+     * Attaching a component to an entity moves the entity into the archetype for its new set of component types.
+     *
+     * The entities themselves, along with their event dispatchers, are allocated from pools owned by the manager.
+     * The storage of deleted entities is recycled for new entities and the pools are released in bulk when the scene
+     * is destroyed.
+     */
     class EntityManager : private NonCopyable
     {
     friend Scene;
     friend Entity;
+    friend EntityQuery;
+    friend EntityView;
     public:
         /**
          * Constructor.
@@ -33,19 +57,138 @@ namespace suborbital
         ~EntityManager();
 
         /**
-         * Returns a copy of the special set containing all of the entities in the scene.
+         * Returns a view of the special set containing all of the entities in the scene.
          *
-         * @return Set containing all of the entities in the scene.
+         * The view refers to the manager's storage and does not copy the set.
+         *
+         * @return View of all of the entities in the scene.
          */
-        const EntitySet all() const;
+        EntityView all() const;
 
         /**
-         * Returns a copy of the set of entities for the group specified by the provided `group_name`.
+         * Returns a view of the set of entities for the group specified by the provided `group_name`.
+         *
+         * The view refers to the manager's storage and does not copy the set. An empty view is returned if no entity
+         * has been added to the group.
          *
          * @param group_name Name of the group.
-         * @return Set containing all of the entities in the group.
+         * @return View of all of the entities in the group.
+         */
+        EntityView group(const std::string& group_name) const;
+
+        /**
+         * Finds the entities that are members of all of the groups specified by the provided `group_names`.
+         *
+         * Each entity records the groups that it belongs to as a set of bits, indexed by group identifier. The
+         * smallest of the groups is scanned and each of its entities is tested against all of the groups at once.
+         *
+         * @param group_names Names of the groups.
+         * @return Set of the entities that are members of every group.
+         */
+        EntitySet intersect_groups(const std::vector<std::string>& group_names) const;
+
+        /**
+         * Looks up the identifier for the specified entity name, assigning a new identifier if the name has not been
+         * used before.
+         *
+         * Looking entities up by identifier avoids hashing the name on each lookup, so scripts that repeatedly search
+         * for the same name should obtain its identifier once and reuse it.
+         *
+         * @param entity_name Entity name.
+         * @return Identifier for the name.
+         */
+        EntityNameId name_id(const std::string& entity_name);
+
+        /**
+         * Searches the scene for an entity with the specified `name`. Child entities are not searched.
+         *
+         * This function has average constant time complexity, O(1), provided that few entities share the name.
+         *
+         * @param entity_name Name of the entity to search for.
+         * @return Pointer to an entity having the specified `name`, or a nullptr if no such entity was found.
+         */
+        WatchPtr<Entity> find_by_name(const std::string& entity_name) const;
+
+        /**
+         * Searches the scene for an entity with the name denoted by the specified identifier. Child entities are not
+         * searched.
+         *
+         * @param name Identifier for the name of the entity to search for.
+         * @return Pointer to an entity having the specified name, or a nullptr if no such entity was found.
          */
-        const EntitySet group(const std::string& group_name) const;
+        WatchPtr<Entity> find_by_name(EntityNameId name) const;
+
+        /**
+         * Checks whether the entity referred to by the specified `handle` still exists.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param handle Handle to the entity.
+         * @return True if the entity has not yet been deleted, false otherwise.
+         */
+        bool valid(EntityHandle handle) const;
+
+        /**
+         * Resolves the specified `handle` to the entity that it refers to.
+         *
+         * A nullptr is returned in the event that the entity has been deleted (or the handle is null). Note that
+         * entities that have been marked for destruction are only deleted after all of the entities in the scene have
+         * been updated.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param handle Handle to the entity.
+         * @return Pointer to the entity, or a nullptr if the entity no longer exists.
+         */
+        Entity* get(EntityHandle handle) const;
+
+        /**
+         * Returns the query for the entities that have components of all of the templated types attached.
+         *
+         * Queries are cached, so the same query is returned each time for a given set of component types, and are
+         * kept up to date as archetypes are created. Iterating over the query only visits the matching entities.
+         *
+         * @return Reference to the query.
+         */
+        template<typename... ComponentTypes>
+        EntityQuery& query()
+        {
+            return query(Archetype::Signature{Type<ComponentTypes>::id()...});
+        }
+
+        /**
+         * Returns the query for the entities that have components with all of the specified class names attached.
+         *
+         * This function is intended to be called from within scripts. Users of the c++ API should use the templated
+         * function provided.
+         *
+         * Class names that have never been used for a component match no entities.
+         *
+         * @param class_names Class names for the component types.
+         * @return Reference to the query.
+         */
+        EntityQuery& query(const std::vector<std::string>& class_names);
+
+        /**
+         * Accessor for the scene's own command buffer.
+         *
+         * Structural changes recorded in this buffer are applied, along with those in any submitted buffers, at the
+         * end of each call to `Scene::process`. This buffer should only be used from the thread that processes the
+         * scene. Other threads should record into their own buffers and `submit` them.
+         *
+         * @return Reference to the command buffer.
+         */
+        CommandBuffer& commands();
+
+        /**
+         * Hands the commands recorded in the supplied `buffer` over to the manager, to be applied at the end of the
+         * next call to `Scene::process`. The buffer is left empty and may be reused.
+         *
+         * This function may be called from any thread.
+         *
+         * @param buffer Command buffer to submit.
+         */
+        void submit(CommandBuffer& buffer);
 
         /**
          * Adds the specified `entity` to the group denoted by the provided `group_name`.
@@ -72,6 +215,22 @@ namespace suborbital
          */
         void remove_from_all_groups(WatchPtr<Entity> entity);
 
+    private:
+        /**
+         * Identifier for a group. Group names are assigned identifiers in the order that they are first used.
+         */
+        typedef std::size_t GroupId;
+
+        /**
+         * Value returned by `find_group` for group names that have not been used.
+         */
+        static const GroupId no_group;
+
+        /**
+         * Value returned by `find_name` for names that have not been used, and stored by unnamed entities.
+         */
+        static const EntityNameId no_name;
+
     private:
         /**
          * Creates a new entity.
@@ -90,6 +249,83 @@ namespace suborbital
          */
         WatchPtr<Entity> create(const std::string& entity_name);
 
+        /**
+         * Allocates and constructs an entity from the entity pool.
+         *
+         * The entity is neither added to the set of all entities nor given a parent.
+         *
+         * @return Pointer to the constructed entity.
+         */
+        Entity* create_entity();
+
+        /**
+         * Allocates and constructs an entity with the specified `entity_name` from the entity pool.
+         *
+         * The entity is neither added to the set of all entities nor given a parent.
+         *
+         * @param entity_name Name for the entity.
+         * @return Pointer to the constructed entity.
+         */
+        Entity* create_entity(const std::string& entity_name);
+
+        /**
+         * Destructs the specified `entity`, along with its children, and returns its storage to the entity pool.
+         *
+         * @param entity Pointer to an entity created by `create_entity`.
+         */
+        void delete_entity(Entity* entity);
+
+        /**
+         * Allocates and constructs an event dispatcher from the dispatcher pool.
+         *
+         * @param observer Object to notify when event types gain or lose all of their subscribers.
+         * @return Pointer to the constructed event dispatcher.
+         */
+        EventDispatcher* create_dispatcher(SubscriptionObserver* observer);
+
+        /**
+         * Destructs the specified `dispatcher` and returns its storage to the dispatcher pool.
+         *
+         * @param dispatcher Pointer to an event dispatcher created by `create_dispatcher`.
+         */
+        void delete_dispatcher(EventDispatcher* dispatcher);
+
+        /**
+         * Records that the specified `entity` has subscribers for the specified event type.
+         *
+         * @param entity Pointer to the entity.
+         * @param event_type Identifier for the event type.
+         */
+        void index_subscriber(Entity* entity, EventTypeId event_type);
+
+        /**
+         * Records that the specified `entity` no longer has subscribers for the specified event type.
+         *
+         * @param entity Pointer to the entity.
+         * @param event_type Identifier for the event type.
+         */
+        void unindex_subscriber(Entity* entity, EventTypeId event_type);
+
+        /**
+         * Accessor for the entities (including child entities) that have subscribers for the specified event type.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param event_type Identifier for the event type.
+         * @return View of the entities, in no particular order.
+         */
+        EntityView subscribers(EventTypeId event_type) const;
+
+        /**
+         * Checks whether any entity has subscribers for the specified event type.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param event_type Identifier for the event type.
+         * @return True if at least one entity has subscribers, false otherwise.
+         */
+        bool has_subscribers(EventTypeId event_type) const;
+
         /**
          * Removes the specified `entity` from all groups, including the special `all` group.
          *
@@ -106,31 +342,290 @@ namespace suborbital
          */
         void purge();
 
+        /**
+         * Looks up the identifier for the group specified by the provided `group_name`.
+         *
+         * @param group_name Name of the group.
+         * @return Identifier for the group, or `no_group` if no entity has been added to the group.
+         */
+        GroupId find_group(const std::string& group_name) const;
+
+        /**
+         * Looks up the identifier for the group specified by the provided `group_name`, assigning a new identifier
+         * (and creating an empty set of entities for the group) if the group name has not been used before.
+         *
+         * @param group_name Name of the group.
+         * @return Identifier for the group.
+         */
+        GroupId intern_group(const std::string& group_name);
+
+        /**
+         * Looks up the identifier for the specified entity name, without assigning a new identifier.
+         *
+         * @param entity_name Entity name.
+         * @return Identifier for the name, or `no_name` if the name has not been used.
+         */
+        EntityNameId find_name(const std::string& entity_name) const;
+
+        /**
+         * Finds an alive entity with the name denoted by the specified identifier.
+         *
+         * Either the entities sharing the name or the entities in the group are scanned, whichever are fewer.
+         *
+         * @param name Identifier for the entity name.
+         * @param group Identifier for the group to search, or `no_group` to search the entities that are not children.
+         * @return Pointer to the entity, or a nullptr if no such entity was found.
+         */
+        Entity* find_named(EntityNameId name, GroupId group) const;
+
+        /**
+         * Adds the specified `entity` to the name index, if it is named.
+         *
+         * @param entity Pointer to the entity.
+         */
+        void index_name(Entity* entity);
+
+        /**
+         * Removes the specified `entity` from the name index, if it is named.
+         *
+         * @param entity Pointer to the entity.
+         */
+        void unindex_name(Entity* entity);
+
+        /**
+         * Applies all of the submitted commands, along with those recorded in the scene's own command buffer.
+         *
+         * Commands are sorted by the entity that they target, so that all of the changes to each entity are applied
+         * together, whilst preserving the order in which the commands for any one entity were recorded.
+         */
+        void execute();
+
+        /**
+         * Updates the behaviours belonging to all of the alive entities in the scene, including child entities.
+         *
+         * Behaviours are updated archetype by archetype. Entities that are created, or that have components attached,
+         * during the update are not updated until the next call to `update`.
+         *
+         * @param dt Time elapsed (in seconds) since the previous call to update.
+         */
+        void update(double dt);
+
+        /**
+         * Assigns a slot to the specified `entity` and stores it, without any components attached, in the component
+         * storage.
+         *
+         * This function is called by the entity's constructor.
+         *
+         * @param entity Pointer to the entity to store.
+         */
+        void attach(Entity* entity);
+
+        /**
+         * Removes the specified `entity` from the component storage, deletes all of its components and releases its
+         * slot for reuse.
+         *
+         * This function is called by the entity's destructor.
+         *
+         * @param entity Pointer to the entity to remove.
+         */
+        void detach(Entity* entity);
+
+        /**
+         * Attaches the supplied `component` to the specified `entity`, moving the entity into the archetype for its
+         * new set of component types.
+         *
+         * @note The component storage takes ownership of the component.
+         *
+         * @param entity Pointer to the entity that the component should be attached to.
+         * @param type Identifier for the component type.
+         * @param component Pointer to the component to attach.
+         * @param behaviour Whether the component is a behaviour.
+         */
+        void attach_component(Entity* entity, ComponentTypeId type, Component* component, bool behaviour);
+
+        /**
+         * Removes the first component with the specified `type` from the specified `entity`, moving the entity into
+         * the archetype for its new set of component types, and destroys the component.
+         *
+         * Nothing is done if the entity has no such component attached.
+         *
+         * @param entity Pointer to the entity that the component should be removed from.
+         * @param type Identifier for the component type.
+         */
+        void detach_component(Entity* entity, ComponentTypeId type);
+
+        /**
+         * Checks whether components with the specified type identifier have been attached as behaviours.
+         *
+         * @param type Identifier for the component type.
+         * @return True if components of the type are behaviours, false otherwise or if no such component has been
+         * attached to an entity in the scene.
+         */
+        bool is_behaviour(ComponentTypeId type) const;
+
+        /**
+         * Returns the query for the entities that have components of all of the specified types attached, creating
+         * it if it does not already exist.
+         *
+         * @param types Component types (in any order, duplicates ignored).
+         * @return Reference to the query.
+         */
+        EntityQuery& query(Archetype::Signature types);
+
+        /**
+         * Acquires an iteration lock on the component storage.
+         *
+         * Whilst the storage is locked, rows are vacated rather than removed, so that no rows are moved. A snapshot of
+         * the number of rows in each archetype is taken when the first lock is acquired, so that iteration does not
+         * visit entities that are created, or that have components attached, whilst locked.
+         */
+        void lock();
+
+        /**
+         * Releases an iteration lock on the component storage, removing any vacated rows once all locks have been
+         * released.
+         */
+        void unlock();
+
+        /**
+         * Returns the archetype with the specified `signature`, creating it if it does not already exist.
+         *
+         * @param signature Sorted list of component types.
+         * @return Reference to the archetype.
+         */
+        Archetype& archetype(const Archetype::Signature& signature);
+
+    private:
+        /**
+         * Slot that an entity occupies.
+         */
+        struct Slot
+        {
+            /**
+             * Pointer to the entity occupying the slot, or a nullptr if the slot is free.
+             */
+            Entity* entity;
+
+            /**
+             * Generation of the slot, incremented each time that the slot is released.
+             */
+            std::uint32_t generation;
+        };
+
     private:
         /**
          * Reference to the parent scene.
          */
         Scene& m_scene;
 
+        /**
+         * Storage for the event dispatchers of the entities.
+         *
+         * @note Declared before the entity pool so that it outlives any entities.
+         */
+        ObjectPool<EventDispatcher> m_dispatcher_pool;
+
+        /**
+         * Storage for the entities (including child entities).
+         */
+        ObjectPool<Entity> m_entity_pool;
+
         /**
          * All the entities.
          */
         EntitySet m_entities;
 
         /**
-         * Map from group names to sets of entities.
+         * Map from group names to group identifiers.
+         */
+        std::unordered_map<std::string, GroupId> m_group_ids;
+
+        /**
+         * Sets of entities for each group, indexed by group identifier.
+         */
+        std::vector<std::unique_ptr<EntitySet>> m_groups;
+
+        /**
+         * Map from entity names to name identifiers.
          */
-        std::unordered_map<std::string, EntitySet> m_entities_by_group;
+        std::unordered_map<std::string, EntityNameId> m_name_ids;
 
         /**
-         * Map from entities to sets of groups.
+         * Entities (including child entities) sharing each name, indexed by name identifier.
          */
-        std::unordered_map<Entity*, std::set<std::string>> m_groups_by_entity;
+        std::vector<std::vector<Entity*>> m_entities_by_name;
+
+        /**
+         * Sets of entities (including child entities) that have subscribers, indexed by event type identifier.
+         */
+        std::vector<std::unique_ptr<EntitySet>> m_subscribers;
 
         /**
          * Entities that have been marked for destruction.
          */
         std::vector<Entity*> m_destroyed;
+
+        /**
+         * Slots for all of the entities in the scene (including child entities), indexed by handle index.
+         */
+        std::vector<Slot> m_slots;
+
+        /**
+         * Indices of the slots that are free for reuse.
+         */
+        std::vector<std::uint32_t> m_free_slots;
+
+        /**
+         * Whether each component type (indexed by identifier) is a behaviour.
+         */
+        std::vector<bool> m_behaviour_types;
+
+        /**
+         * Archetypes in order of creation.
+         */
+        std::vector<std::unique_ptr<Archetype>> m_archetypes;
+
+        /**
+         * Map from signatures to archetypes.
+         */
+        std::map<Archetype::Signature, Archetype*> m_archetypes_by_signature;
+
+        /**
+         * The scene's own command buffer.
+         */
+        CommandBuffer m_commands;
+
+        /**
+         * Commands submitted for application at the end of the next call to `Scene::process`.
+         */
+        std::vector<CommandBuffer::Command> m_submitted;
+
+        /**
+         * Number of entities whose creation has been submitted.
+         */
+        std::size_t m_submitted_created;
+
+        /**
+         * Mutex guarding the submitted commands.
+         */
+        std::mutex m_submitted_mutex;
+
+        /**
+         * Cached queries, keyed by their sorted component types.
+         */
+        std::map<Archetype::Signature, std::unique_ptr<EntityQuery>> m_queries;
+
+        /**
+         * Number of iteration locks held on the component storage, either by an update or by query iterators.
+         *
+         * Rows are vacated, rather than removed, whilst locked in order that no rows are moved whilst iterating.
+         */
+        std::size_t m_locks;
+
+        /**
+         * Whether any rows have been vacated since the component storage was last compacted.
+         */
+        bool m_vacated;
     };
 }
 
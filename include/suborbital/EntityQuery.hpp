@@ -0,0 +1,235 @@
+#ifndef SUBORBITAL_ENTITY_QUERY_HPP
+#define SUBORBITAL_ENTITY_QUERY_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <suborbital/NonCopyable.hpp>
+#include <suborbital/Archetype.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class Entity;
+    class EntityManager;
+
+    /**
+     * Cached query for the entities that have a particular set of component types attached.
+     *
+     * Queries are created and owned by the `EntityManager` (see `EntityManager::query`). Rather than storing the
+     * matching entities, a query stores the archetypes whose signatures include all of the queried component types.
+     * The list of archetypes is maintained incrementally: each archetype is tested once when it is created, so that
+     * iterating over a query only visits matching entities. Entities that are marked for destruction are skipped.
+     *
+     * @note Component types are matched exactly. Unlike `Entity::has_attribute`, querying for a base class does not
+     * match components of derived classes.
+     */
+    class EntityQuery : private NonCopyable
+    {
+    friend EntityManager;
+    public:
+        /**
+         * Iterator to an entity matching the query.
+         *
+         * Whilst any iterator exists, components attached to (and entities deleted from) the scene leave their
+         * previous storage in place, so that entities may safely be modified whilst iterating. Each matching entity
+         * is visited once. Entities that are created, or that come to match the query, during iteration are not
+         * visited.
+         */
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef Entity* value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef Entity* const* pointer;
+            typedef Entity* reference;
+
+        public:
+            /**
+             * Constructor.
+             *
+             * The iterator is advanced to the first matching entity at or after the specified position.
+             *
+             * @param query Query to iterate over.
+             * @param archetype Index into the query's list of matching archetypes.
+             * @param row Row of the archetype.
+             */
+            const_iterator(const EntityQuery* query, std::size_t archetype, std::size_t row);
+
+            /**
+             * Copy constructor.
+             *
+             * @param other The other iterator to copy from.
+             */
+            const_iterator(const const_iterator& other);
+
+            /**
+             * Destructor.
+             */
+            ~const_iterator();
+
+            /**
+             * Copy assignment operator.
+             *
+             * @param other The other iterator to copy from.
+             */
+            const_iterator& operator=(const const_iterator& other);
+
+            /**
+             * Dereference operator.
+             *
+             * @return Pointer to the entity.
+             */
+            Entity* operator*() const;
+
+            /**
+             * Pre-increment operator.
+             *
+             * @return Reference to this iterator, having been advanced to the next matching entity.
+             */
+            const_iterator& operator++();
+
+            /**
+             * Post-increment operator.
+             *
+             * @return Copy of this iterator from before it was advanced to the next matching entity.
+             */
+            const_iterator operator++(int);
+
+            /**
+             * Equality operator.
+             *
+             * @param other The other iterator to compare with.
+             * @return True if the two iterators refer to the same position, false otherwise.
+             */
+            bool operator==(const const_iterator& other) const;
+
+            /**
+             * Inequality operator.
+             *
+             * @param other The other iterator to compare with.
+             * @return True if the two iterators refer to different positions, false otherwise.
+             */
+            bool operator!=(const const_iterator& other) const;
+
+        private:
+            /**
+             * Advances the iterator past any rows that do not hold an alive entity.
+             */
+            void skip();
+
+        private:
+            /**
+             * Query being iterated over.
+             */
+            const EntityQuery* m_query;
+
+            /**
+             * Index into the query's list of matching archetypes.
+             */
+            std::size_t m_archetype;
+
+            /**
+             * Row of the archetype.
+             */
+            std::size_t m_row;
+        };
+
+        /**
+         * Iterator to an entity matching the query.
+         */
+        typedef const_iterator iterator;
+
+    public:
+        /**
+         * Destructor.
+         */
+        ~EntityQuery();
+
+        /**
+         * Accessor for the component types that the query matches.
+         *
+         * @return Sorted list of the queried component types.
+         */
+        const Archetype::Signature& signature() const;
+
+        /**
+         * Counts the entities matching the query.
+         *
+         * This function has time complexity linear in the number of matching entities, O(n).
+         *
+         * @return Number of matching alive entities.
+         */
+        std::size_t size() const;
+
+        /**
+         * Checks whether no entities match the query.
+         *
+         * @return True if no alive entities match the query, false otherwise.
+         */
+        bool empty() const;
+
+        /**
+         * Returns an iterator referring to the first entity matching the query.
+         *
+         * @return Iterator to the first matching entity.
+         */
+        const_iterator begin() const;
+
+        /**
+         * Returns an iterator referring to the past-the-end entity.
+         *
+         * @return Iterator to the past-the-end entity.
+         */
+        const_iterator end() const;
+
+    private:
+        /**
+         * Constructor.
+         *
+         * @param manager Entity manager that owns the query.
+         * @param signature Sorted list of the component types to match, without duplicates.
+         */
+        EntityQuery(EntityManager& manager, const Archetype::Signature& signature);
+
+        /**
+         * Adds the specified `archetype` to the list of matching archetypes, if its signature includes the queried
+         * component types.
+         *
+         * This function is called by the entity manager for each archetype that is created.
+         *
+         * @param archetype Reference to the archetype.
+         */
+        void consider(Archetype& archetype);
+
+        /**
+         * Acquires an iteration lock on the entity manager's storage.
+         */
+        void lock() const;
+
+        /**
+         * Releases an iteration lock on the entity manager's storage.
+         */
+        void unlock() const;
+
+    private:
+        /**
+         * Entity manager that owns the query.
+         */
+        EntityManager& m_manager;
+
+        /**
+         * Queried component types.
+         */
+        Archetype::Signature m_signature;
+
+        /**
+         * Archetypes whose signatures include all of the queried component types.
+         */
+        std::vector<Archetype*> m_archetypes;
+    };
+}
+
+#endif
\ No newline at end of file
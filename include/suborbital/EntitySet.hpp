@@ -1,7 +1,10 @@
 #ifndef SUBORBITAL_ENTITY_GROUP_HPP
 #define SUBORBITAL_ENTITY_GROUP_HPP
 
-#include <set>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include <suborbital/WatchPtr.hpp>
 
@@ -9,24 +12,163 @@ namespace suborbital
 {
     // Forward declarations.
     class Entity;
+    class EntityView;
 
     /**
      * Represents a set of entities.
      *
      * No duplicates of an entity may exist in the set.
+     *
+     * The set is implemented as a sparse set. The entities are stored contiguously in a dense array in the order that
+     * they were inserted, and a sparse array indexed by the entities' handle indices maps each entity to its position
+     * in the dense array. Removed entities leave a null pointer (tombstone) in the dense array, which is skipped when
+     * iterating, so that the remaining entities retain their insertion order. Tombstones are compacted away once
+     * they outnumber the entities in the set.
+     *
+     * @note Since entities are keyed by their handle indices, a set may only contain entities from a single scene.
      */
     class EntitySet
     {
+    friend EntityView;
     public:
         /**
-         * Iterator to an entity in the set.
+         * Iterator to a const entity in the set.
+         *
+         * Iterators remain valid when entities are removed from the set, but may be invalidated by insertions.
          */
-        typedef std::set<WatchPtr<Entity>>::iterator iterator;
+        class const_iterator
+        {
+        friend EntitySet;
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef WatchPtr<Entity> value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const WatchPtr<Entity>* pointer;
+            typedef const WatchPtr<Entity>& reference;
+
+        public:
+            /**
+             * Constructor.
+             *
+             * Constructs an iterator that does not refer to any set.
+             */
+            const_iterator()
+            : m_set(nullptr)
+            , m_position(0)
+            {
+                // Nothing to do.
+            }
+
+            /**
+             * Dereference operator.
+             *
+             * @return Reference to the pointer to the entity.
+             */
+            reference operator*() const
+            {
+                return m_set->m_dense[m_position];
+            }
+
+            /**
+             * Arrow operator.
+             *
+             * @return Pointer to the pointer to the entity.
+             */
+            pointer operator->() const
+            {
+                return &m_set->m_dense[m_position];
+            }
+
+            /**
+             * Pre-increment operator.
+             *
+             * @return Reference to this iterator, having been advanced to the next entity in the set.
+             */
+            const_iterator& operator++()
+            {
+                ++m_position;
+                skip();
+                return *this;
+            }
+
+            /**
+             * Post-increment operator.
+             *
+             * @return Copy of this iterator from before it was advanced to the next entity in the set.
+             */
+            const_iterator operator++(int)
+            {
+                const_iterator previous(*this);
+                ++(*this);
+                return previous;
+            }
+
+            /**
+             * Equality operator.
+             *
+             * @param other The other iterator to compare with.
+             * @return True if the two iterators refer to the same position in the same set, false otherwise.
+             */
+            bool operator==(const const_iterator& other) const
+            {
+                return m_set == other.m_set && m_position == other.m_position;
+            }
+
+            /**
+             * Inequality operator.
+             *
+             * @param other The other iterator to compare with.
+             * @return True if the two iterators refer to different positions, false otherwise.
+             */
+            bool operator!=(const const_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            /**
+             * Constructor.
+             *
+             * The iterator is advanced past any tombstones at the specified `position`.
+             *
+             * @param set Set to iterate over.
+             * @param position Position in the set's dense array.
+             */
+            const_iterator(const EntitySet* set, std::size_t position)
+            : m_set(set)
+            , m_position(position)
+            {
+                skip();
+            }
+
+            /**
+             * Advances the iterator past any tombstones.
+             */
+            void skip()
+            {
+                const std::vector<WatchPtr<Entity>>& dense = m_set->m_dense;
+                while (m_position < dense.size() && !dense[m_position])
+                {
+                    ++m_position;
+                }
+            }
+
+        private:
+            /**
+             * Set being iterated over.
+             */
+            const EntitySet* m_set;
+
+            /**
+             * Position in the set's dense array.
+             */
+            std::size_t m_position;
+        };
 
         /**
-         * Iterator to a const entity in the set.
+         * Iterator to an entity in the set.
          */
-        typedef std::set<WatchPtr<Entity>>::const_iterator const_iterator;
+        typedef const_iterator iterator;
 
     public:
         /**
@@ -71,27 +213,27 @@ namespace suborbital
          * Searches the set for the specified entity and returns an iterator to it if found, otherwise returns an
          * iterator to `end`.
          *
-         * This function has time complexity logarithmic in the size of the set, O(1og n).
+         * This function has constant time complexity, O(1).
          *
          * @return Iterator to the specified entity in the set or `end` if the entity was not found.
          */
-        iterator find(WatchPtr<Entity> entity);
+        iterator find(const WatchPtr<Entity>& entity);
 
         /**
          * Searches the set for the specified entity and returns an iterator to it if found, otherwise returns an
          * iterator to `end`.
          *
-         * This function has time complexity logarithmic in the size of the set, O(1og n).
+         * This function has constant time complexity, O(1).
          *
          * @return Iterator to the specified entity in the set or `end` if the entity was not found.
          */
-        const_iterator find(WatchPtr<Entity> entity) const;
+        const_iterator find(const WatchPtr<Entity>& entity) const;
 
         /**
          * Searches for an entity with the specified `name` and returns an iterator to it if found, otherwise returns
          * an iterator to `end`.
          *
-         * Note that this function performs a linear search and has time complexity logarithmic in the size of the set,
+         * Note that this function performs a linear search and has time complexity linear in the size of the set,
          * O(n). Avoid calling this function every frame and cache the result where possible.
          *
          * @param entity_name Name of the entity to search for.
@@ -103,7 +245,7 @@ namespace suborbital
          * Searches for an entity with the specified `name` and returns an iterator to it if found, otherwise returns
          * an iterator to `end`.
          *
-         * Note that this function performs a linear search and has time complexity logarithmic in the size of the set,
+         * Note that this function performs a linear search and has time complexity linear in the size of the set,
          * O(n). Avoid calling this function every frame and cache the result where possible.
          *
          * @param entity_name Name of the entity to search for.
@@ -114,7 +256,11 @@ namespace suborbital
         /**
          * Inserts the supplied entity into the set.
          *
-         * This function has time complexity logarithmic in the size of the set, O(1og n).
+         * The entity is appended after all of the entities already in the set. Inserting an entity that is already
+         * in the set has no effect.
+         *
+         * This function has amortized constant time complexity, O(1). Note that inserting an entity may invalidate
+         * existing iterators.
          *
          * @param entity Entity to be added into the set.
          * @return Iterator to the inserted entity.
@@ -124,7 +270,7 @@ namespace suborbital
         /**
          * Removes the entity at the specified `position` from the set.
          *
-         * This function has time complexity logarithmic in the size of the set, O(1og n).
+         * This function has constant time complexity, O(1).
          *
          * @param position Iterator to the entity to remove from the set.
          * @return Iterator to the next entity in the set.
@@ -134,15 +280,18 @@ namespace suborbital
         /**
          * Finds and removes the specified entity from the set.
          *
-         * This function has time complexity logarithmic in the size of the set, O(1og n).
+         * This function has constant time complexity, O(1).
          *
          * @param entity Pointer to the entity to remove from the set.
          * @return True if the specified entity was found and removed, false otherwise.
          */
-        bool remove(WatchPtr<Entity> entity);
+        bool remove(const WatchPtr<Entity>& entity);
 
         /**
          * Removes all entities from the set.
+         *
+         * Whilst the set is locked for iteration the entities are replaced by tombstones, rather than the storage
+         * being released, so that iteration is unaffected.
          */
         void clear();
 
@@ -180,11 +329,45 @@ namespace suborbital
 
     private:
         /**
-         * Entities in the set.
-         *
-         * TODO: Change implementation to use std::unordered_set when this is supported by SWIG.
+         * Removes the tombstones from the dense array, preserving the order of the remaining entities.
+         */
+        void compact();
+
+        /**
+         * Acquires an iteration lock, deferring compaction until all locks have been released.
+         */
+        void lock() const;
+
+        /**
+         * Releases an iteration lock.
+         */
+        void unlock() const;
+
+    private:
+        /**
+         * Value in the sparse array for entities that are not in the set.
+         */
+        static const std::size_t npos;
+
+        /**
+         * Entities in the set, in insertion order. Removed entities are replaced by null pointers.
+         */
+        std::vector<WatchPtr<Entity>> m_dense;
+
+        /**
+         * Positions in the dense array, indexed by entity handle index.
+         */
+        std::vector<std::size_t> m_sparse;
+
+        /**
+         * Number of entities in the set.
+         */
+        std::size_t m_size;
+
+        /**
+         * Number of iteration locks held on the set.
          */
-        std::set<WatchPtr<Entity>> m_entities;
+        mutable std::size_t m_locks;
     };
 }
 
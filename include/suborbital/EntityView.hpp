@@ -0,0 +1,331 @@
+#ifndef SUBORBITAL_ENTITY_VIEW_HPP
+#define SUBORBITAL_ENTITY_VIEW_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+#include <suborbital/WatchPtr.hpp>
+#include <suborbital/Entity.hpp>
+#include <suborbital/EntitySet.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class EntityManager;
+
+    /**
+     * Read-only view of an entity set.
+     *
+     * A view refers to an `EntitySet` owned by the `EntityManager` without copying it, so constructing and copying
+     * views is cheap regardless of the number of entities. Views are live: they reflect entities that are added to,
+     * or removed from, the underlying set after the view was created.
+     *
+     * Whilst any iterator obtained from a view exists, the underlying set defers compacting its storage, so that
+     * entities may safely be created or destroyed whilst iterating. Entities removed from the set during iteration
+     * are skipped. Entities added during iteration are visited only if the end iterator is re-evaluated; loops that
+     * obtain the end iterator once (such as range-based for loops) visit only the entities present when iteration
+     * began.
+     *
+     * @note A view must not outlive the entity manager that it was obtained from.
+     */
+    class EntityView
+    {
+    friend EntityManager;
+    public:
+        /**
+         * Iterator to a const entity in the view.
+         *
+         * The iterator holds an iteration lock on the underlying set for its lifetime.
+         */
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef WatchPtr<Entity> value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const WatchPtr<Entity>* pointer;
+            typedef const WatchPtr<Entity>& reference;
+
+        public:
+            /**
+             * Constructor.
+             *
+             * @param set Set that the iterator refers to (may be a nullptr for iterators of an empty view).
+             * @param iterator Position in the set.
+             */
+            const_iterator(const EntitySet* set, EntitySet::const_iterator iterator)
+            : m_set(set)
+            , m_iterator(iterator)
+            {
+                lock();
+            }
+
+            /**
+             * Copy constructor.
+             *
+             * @param other The other iterator to copy from.
+             */
+            const_iterator(const const_iterator& other)
+            : m_set(other.m_set)
+            , m_iterator(other.m_iterator)
+            {
+                lock();
+            }
+
+            /**
+             * Destructor.
+             */
+            ~const_iterator()
+            {
+                unlock();
+            }
+
+            /**
+             * Copy assignment operator.
+             *
+             * @param other The other iterator to copy from.
+             */
+            const_iterator& operator=(const const_iterator& other)
+            {
+                if (m_set != other.m_set)
+                {
+                    unlock();
+                    m_set = other.m_set;
+                    lock();
+                }
+
+                m_iterator = other.m_iterator;
+                return *this;
+            }
+
+            /**
+             * Dereference operator.
+             *
+             * @return Reference to the pointer to the entity.
+             */
+            reference operator*() const
+            {
+                return *m_iterator;
+            }
+
+            /**
+             * Arrow operator.
+             *
+             * @return Pointer to the pointer to the entity.
+             */
+            pointer operator->() const
+            {
+                return m_iterator.operator->();
+            }
+
+            /**
+             * Pre-increment operator.
+             *
+             * @return Reference to this iterator, having been advanced to the next entity in the view.
+             */
+            const_iterator& operator++()
+            {
+                ++m_iterator;
+                return *this;
+            }
+
+            /**
+             * Post-increment operator.
+             *
+             * @return Copy of this iterator from before it was advanced to the next entity in the view.
+             */
+            const_iterator operator++(int)
+            {
+                const_iterator previous(*this);
+                ++m_iterator;
+                return previous;
+            }
+
+            /**
+             * Equality operator.
+             *
+             * @param other The other iterator to compare with.
+             * @return True if the two iterators refer to the same position, false otherwise.
+             */
+            bool operator==(const const_iterator& other) const
+            {
+                return m_iterator == other.m_iterator;
+            }
+
+            /**
+             * Inequality operator.
+             *
+             * @param other The other iterator to compare with.
+             * @return True if the two iterators refer to different positions, false otherwise.
+             */
+            bool operator!=(const const_iterator& other) const
+            {
+                return m_iterator != other.m_iterator;
+            }
+
+        private:
+            /**
+             * Acquires an iteration lock on the set.
+             */
+            void lock()
+            {
+                if (m_set != nullptr)
+                {
+                    m_set->lock();
+                }
+            }
+
+            /**
+             * Releases the iteration lock on the set.
+             */
+            void unlock()
+            {
+                if (m_set != nullptr)
+                {
+                    m_set->unlock();
+                }
+            }
+
+        private:
+            /**
+             * Set that the iterator refers to.
+             */
+            const EntitySet* m_set;
+
+            /**
+             * Position in the set.
+             */
+            EntitySet::const_iterator m_iterator;
+        };
+
+        /**
+         * Iterator to an entity in the view.
+         */
+        typedef const_iterator iterator;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * Constructs an empty view.
+         */
+        EntityView();
+
+        /**
+         * Constructor.
+         *
+         * @param set Set to view.
+         */
+        explicit EntityView(const EntitySet& set);
+
+        /**
+         * Destructor.
+         */
+        ~EntityView();
+
+        /**
+         * Accessor for the number of entities in the view.
+         *
+         * @return The number of entities in the view.
+         */
+        std::size_t size() const;
+
+        /**
+         * Checks whether the view is empty (i.e. whether its `size` is zero).
+         *
+         * @return True if the view contains no entities, false otherwise.
+         */
+        bool empty() const;
+
+        /**
+         * Checks whether the view contains the specified entity.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param entity Pointer to the entity to search for.
+         * @return True if the entity is in the view, false otherwise.
+         */
+        bool contains(const WatchPtr<Entity>& entity) const;
+
+        /**
+         * Searches for an entity with the specified `name`.
+         *
+         * Views obtained from the `EntityManager` look the name up in the manager's name index, which has average
+         * constant time complexity, O(1), provided that few entities share the name. Other views perform a linear
+         * search.
+         *
+         * @param entity_name Name of the entity to search for.
+         * @return Pointer to an entity in the view having the specified `name`, or a nullptr if no such entity was
+         * found.
+         */
+        WatchPtr<Entity> find_by_name(const std::string& entity_name) const;
+
+        /**
+         * Searches for an entity with the name denoted by the specified identifier.
+         *
+         * This overload avoids hashing the name on each call (see `EntityManager::name_id`).
+         *
+         * @param name Identifier for the name of the entity to search for.
+         * @return Pointer to an entity in the view having the specified name, or a nullptr if no such entity was found.
+         */
+        WatchPtr<Entity> find_by_name(EntityNameId name) const;
+
+        /**
+         * Returns an iterator referring to the first entity in the view.
+         *
+         * @return Iterator to the first entity in the view.
+         */
+        const_iterator begin() const;
+
+        /**
+         * Returns an iterator referring to the first entity in the view.
+         *
+         * @return Iterator to the first entity in the view.
+         */
+        const_iterator cbegin() const;
+
+        /**
+         * Returns an iterator referring to the past-the-end entity in the view.
+         *
+         * @return Iterator to the past-the-end entity in the view.
+         */
+        const_iterator end() const;
+
+        /**
+         * Returns an iterator referring to the past-the-end entity in the view.
+         *
+         * @return Iterator to the past-the-end entity in the view.
+         */
+        const_iterator cend() const;
+
+    private:
+        /**
+         * Constructor.
+         *
+         * @param set Set to view.
+         * @param manager Entity manager that owns the set.
+         * @param group Identifier for the group that the set holds the entities for, or `EntityManager::no_group` for
+         * the special set containing all of the entities in the scene.
+         */
+        EntityView(const EntitySet& set, const EntityManager& manager, std::size_t group);
+
+    private:
+        /**
+         * Set being viewed (will be a nullptr for an empty view).
+         */
+        const EntitySet* m_set;
+
+        /**
+         * Entity manager that owns the set, used to look up entities by name (may be a nullptr).
+         */
+        const EntityManager* m_manager;
+
+        /**
+         * Identifier for the group that the set holds the entities for.
+         */
+        std::size_t m_group;
+    };
+}
+
+#endif
\ No newline at end of file
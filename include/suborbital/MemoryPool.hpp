@@ -0,0 +1,142 @@
+#ifndef SUBORBITAL_MEMORY_POOL_HPP
+#define SUBORBITAL_MEMORY_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <suborbital/NonCopyable.hpp>
+
+namespace suborbital
+{
+    /**
+     * Fixed-size block allocator.
+     *
+     * Memory is obtained from the system in slabs, each holding a fixed number of blocks of the same size and
+     * alignment. Deallocated blocks are kept on a free list and handed out again by subsequent allocations, so that
+     * repeatedly allocating and deallocating blocks does not touch the system allocator once the pool has grown large
+     * enough. All of the slabs are released together when the pool is destroyed.
+     *
+     * @note The pool only manages raw memory. Objects must be constructed and destructed by the caller.
+     */
+    class MemoryPool : private NonCopyable
+    {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param block_size Size (in bytes) of each block.
+         * @param block_alignment Alignment (in bytes) of each block.
+         * @param blocks_per_slab Number of blocks to obtain from the system at a time.
+         */
+        MemoryPool(std::size_t block_size, std::size_t block_alignment, std::size_t blocks_per_slab = 256);
+
+        /**
+         * Destructor.
+         *
+         * Releases all of the slabs, regardless of whether their blocks have been deallocated.
+         */
+        ~MemoryPool();
+
+        /**
+         * Allocates a block.
+         *
+         * This function has constant time complexity, O(1), except when a new slab must be obtained.
+         *
+         * @return Pointer to the allocated block.
+         */
+        void* allocate();
+
+        /**
+         * Returns the specified `block` to the pool.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param block Pointer to a block previously returned by `allocate`.
+         */
+        void deallocate(void* block);
+
+        /**
+         * Accessor for the size of each block.
+         *
+         * @return Block size in bytes.
+         */
+        std::size_t block_size() const;
+
+        /**
+         * Accessor for the alignment of each block.
+         *
+         * @return Block alignment in bytes.
+         */
+        std::size_t block_alignment() const;
+
+        /**
+         * Accessor for the number of blocks that are currently allocated.
+         *
+         * @return Number of allocated blocks.
+         */
+        std::size_t size() const;
+
+        /**
+         * Accessor for the total number of blocks held by the pool, whether allocated or free.
+         *
+         * @return Number of blocks held.
+         */
+        std::size_t capacity() const;
+
+        /**
+         * Accessor for the largest number of blocks that have been allocated at any one time.
+         *
+         * @return High-water mark for the number of allocated blocks.
+         */
+        std::size_t high_water_mark() const;
+
+    private:
+        /**
+         * Obtains a new slab from the system and adds its blocks to the free list.
+         */
+        void grow();
+
+    private:
+        /**
+         * Size of each block.
+         */
+        const std::size_t m_block_size;
+
+        /**
+         * Alignment of each block.
+         */
+        const std::size_t m_block_alignment;
+
+        /**
+         * Distance (in bytes) between consecutive blocks in a slab.
+         */
+        const std::size_t m_stride;
+
+        /**
+         * Number of blocks obtained per slab.
+         */
+        const std::size_t m_blocks_per_slab;
+
+        /**
+         * Slabs obtained from the system.
+         */
+        std::vector<void*> m_slabs;
+
+        /**
+         * Head of the singly linked list of free blocks, threaded through the blocks themselves.
+         */
+        void* m_free;
+
+        /**
+         * Number of blocks currently allocated.
+         */
+        std::size_t m_size;
+
+        /**
+         * Largest number of blocks allocated at any one time.
+         */
+        std::size_t m_high_water_mark;
+    };
+}
+
+#endif
\ No newline at end of file
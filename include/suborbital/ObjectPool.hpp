@@ -0,0 +1,89 @@
+#ifndef SUBORBITAL_OBJECT_POOL_HPP
+#define SUBORBITAL_OBJECT_POOL_HPP
+
+#include <utility>
+
+#include <suborbital/NonCopyable.hpp>
+#include <suborbital/MemoryPool.hpp>
+
+namespace suborbital
+{
+    /**
+     * Pool of objects of the templated type.
+     *
+     * Constructs objects in memory taken from a `MemoryPool` and returns the memory to the pool when the objects are
+     * destroyed, so that the storage of destroyed objects is recycled.
+     */
+    template<typename T>
+    class ObjectPool : private NonCopyable
+    {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param objects_per_slab Number of objects worth of memory to obtain from the system at a time.
+         */
+        explicit ObjectPool(std::size_t objects_per_slab = 256)
+        : m_memory(sizeof(T), alignof(T), objects_per_slab)
+        {
+            // Nothing to do.
+        }
+
+        /**
+         * Destructor.
+         *
+         * @note Objects that have not been destroyed are NOT destructed; their memory is simply released.
+         */
+        ~ObjectPool() = default;
+
+        /**
+         * Constructs an object from the supplied arguments.
+         *
+         * @param args Arguments to forward to the object's constructor.
+         * @return Pointer to the constructed object.
+         */
+        template<typename... Args>
+        T* create(Args&&... args)
+        {
+            void* block = m_memory.allocate();
+            try
+            {
+                return new (block) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                m_memory.deallocate(block);
+                throw;
+            }
+        }
+
+        /**
+         * Destructs the specified `object` and recycles its memory.
+         *
+         * @param object Pointer to an object previously returned by `create`.
+         */
+        void destroy(T* object)
+        {
+            object->~T();
+            m_memory.deallocate(object);
+        }
+
+        /**
+         * Accessor for the memory pool from which objects are allocated.
+         *
+         * @return Reference to the memory pool.
+         */
+        const MemoryPool& memory() const
+        {
+            return m_memory;
+        }
+
+    private:
+        /**
+         * Memory for the objects.
+         */
+        MemoryPool m_memory;
+    };
+}
+
+#endif
\ No newline at end of file
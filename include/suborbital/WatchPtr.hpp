@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cassert>
 #include <functional>
+#include <utility>
 
 namespace suborbital
 {
@@ -12,6 +13,9 @@ namespace suborbital
 
     /**
      * Base class for the template `WatchPtr` class.
+     *
+     * The watchers of each watchable object form an intrusive doubly-linked list, threaded through the watchers
+     * themselves, so that starting and stopping watching an object are constant time operations that do not allocate.
      */
     class WatchPtrBase
     {
@@ -37,12 +41,33 @@ namespace suborbital
          */
         void unwatch();
 
+        /**
+         * Takes over the `other` watcher's place in the list of watchers for the object that it is watching, leaving
+         * the `other` watcher empty.
+         *
+         * This function has constant time complexity, O(1).
+         *
+         * @param other The watcher to take over from.
+         */
+        void transfer(WatchPtrBase& other) noexcept;
+
         /**
          * Pointer to the object that the WatchPtr is watching.
          *
          * This pointer will be null when the object being watched is deleted.
          */
         const Watchable* ptr;
+
+    private:
+        /**
+         * Previous watcher of the same object, or a nullptr if this is the first watcher.
+         */
+        WatchPtrBase* m_previous;
+
+        /**
+         * Next watcher of the same object, or a nullptr if this is the last watcher.
+         */
+        WatchPtrBase* m_next;
     };
 
     /**
@@ -61,6 +86,7 @@ namespace suborbital
     template<typename T>
     class WatchPtr : public WatchPtrBase
     {
+    template<typename U> friend class WatchPtr;
     public:
         /**
          * Constructor.
@@ -97,6 +123,27 @@ namespace suborbital
             watch(t.ptr);
         }
 
+        /**
+         * Move constructor.
+         *
+         * Takes over the registration of `t` with the watched object, leaving `t` empty.
+         */
+        WatchPtr(WatchPtr&& t) noexcept
+        {
+            transfer(t);
+        }
+
+        /**
+         * Move constructor.
+         *
+         * Takes over the registration of `t` with the watched object, leaving `t` empty.
+         */
+        template<typename U>
+        WatchPtr(WatchPtr<U>&& t) noexcept
+        {
+            transfer(t);
+        }
+
         /**
          * Destructor.
          */
@@ -129,6 +176,36 @@ namespace suborbital
             return *this;
         }
 
+        /**
+         * Move assignment operator.
+         *
+         * Stops watching the current object and takes over the registration of `other`, leaving `other` empty.
+         *
+         * @param other Other WatchPtr to move from.
+         * @return Reference to this WatchPtr.
+         */
+        WatchPtr& operator=(WatchPtr&& other) noexcept
+        {
+            if (this != &other)
+            {
+                transfer(other);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Exchanges the objects watched by this WatchPtr and the `other` WatchPtr.
+         *
+         * @param other The other WatchPtr.
+         */
+        void swap(WatchPtr& other) noexcept
+        {
+            WatchPtr temporary(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temporary);
+        }
+
         /**
          * Dereference operator.
          *
@@ -193,6 +270,18 @@ namespace suborbital
         }
     };
 
+    /**
+     * Exchanges the objects watched by `a` and `b`.
+     *
+     * @param a The first WatchPtr.
+     * @param b The second WatchPtr.
+     */
+    template<typename T>
+    void swap(WatchPtr<T>& a, WatchPtr<T>& b) noexcept
+    {
+        a.swap(b);
+    }
+
     /**
      * Returns a copy of `t` with its stored pointer cast dynamically from `U` to `T`.
      *
@@ -1,33 +1,61 @@
 #ifndef SUBORBITAL_WATCHABLE_HPP
 #define SUBORBITAL_WATCHABLE_HPP
 
-#include <unordered_set>
+#include <atomic>
+#include <cstddef>
 
 #include <suborbital/WatchPtr.hpp>
+#include <suborbital/AtomicWatchPtr.hpp>
 
 namespace suborbital
 {
     /**
      * The base class for all classes that can be watched by watch_ptr's.
+     *
+     * Watchable objects may also be watched by `AtomicWatchPtr`'s from other threads, which may check whether the
+     * objects have been deleted. The objects themselves must still be created, used and deleted by a single thread at
+     * a time.
      */
     class Watchable
     {
     friend WatchPtrBase;
+    friend AtomicWatchPtrBase;
     public:
         /**
          * Constructor.
          */
         Watchable();
 
+        /**
+         * Copy constructor.
+         *
+         * The new object is not watched by the watchers of the `other` object.
+         *
+         * @param other The other watchable object.
+         */
+        Watchable(const Watchable& other);
+
         /**
          * Destructor.
          *
-         * Nulls pointers to the watchable object from every watcher.
+         * Nulls pointers to the watchable object from every watcher, including any atomic watchers.
          */
         virtual ~Watchable();
 
         /**
-         * Returns the number of WatchPtr objects that point to this object.
+         * Copy assignment operator.
+         *
+         * The watchers of both objects are unaffected.
+         *
+         * @param other The other watchable object.
+         * @return Reference to this object.
+         */
+        Watchable& operator=(const Watchable& other);
+
+        /**
+         * Returns the number of WatchPtr objects that point to this object. AtomicWatchPtr objects are not counted.
+         *
+         * This function has time complexity linear in the number of watchers, O(n).
          *
          * @return Number of WatchPtr objects pointing to this object.
          */
@@ -35,9 +63,24 @@ namespace suborbital
 
     private:
         /**
-         * List of watch_ptr's that are pointing to the watchable object.
+         * Returns the token shared with atomic watchers, creating the token if necessary.
+         *
+         * This function may be called concurrently from multiple threads.
+         *
+         * @return Pointer to the token.
+         */
+        WatchToken* token() const;
+
+    private:
+        /**
+         * First of the watch_ptr's that are pointing to the watchable object, or a nullptr if there are none.
+         */
+        mutable WatchPtrBase* m_watchers;
+
+        /**
+         * Token shared with any atomic watchers, or a nullptr if the object has never been watched atomically.
          */
-        mutable std::unordered_set<WatchPtrBase*> m_watchers;
+        mutable std::atomic<WatchToken*> m_token;
     };
 }
 
@@ -5,6 +5,7 @@
 
 #include <suborbital/component/ComponentFactory.hpp>
 #include <suborbital/component/Attribute.hpp>
+#include <suborbital/component/ComponentRegistry.hpp>
 
 namespace suborbital
 {
@@ -30,15 +31,17 @@ namespace suborbital
         /**
          * Instantiates an attribute of the templated type and returns a unique_ptr to the created attribute.
          *
-         * @note The caller is responsible for managing the lifetime of the returned attribute.
+         * The attribute is allocated from the component registry's pool for the type. The returned pointer returns it to
+         * the pool when it is destroyed. Ownership that is released must be passed to
+         * `ComponentRegistry::destroy_component`.
          *
          * @return Unique pointer to the created attribute.
          */
-        std::unique_ptr<Component> create() const
+        std::unique_ptr<Component, ComponentDeleter> create() const
         {
             static_assert(std::is_base_of<Attribute, AttributeType>::value,
                     "Template parameter AttributeType in AttributeFactory is not derived from Attribute");
-            return std::unique_ptr<AttributeType>(new AttributeType());
+            return std::unique_ptr<Component, ComponentDeleter>(component_registry().create_component<AttributeType>());
         }
     };
 }
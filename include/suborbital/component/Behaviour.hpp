@@ -7,6 +7,7 @@ namespace suborbital
 {
     // Forward declarations.
     class Entity;
+    class Archetype;
 
     /**
      * The base class for behaviours that can be attached to entities.
@@ -14,6 +15,7 @@ namespace suborbital
     class Behaviour : public Component
     {
     friend Entity;
+    friend Archetype;
     public:
         /**
          * Destructor.
@@ -9,6 +9,8 @@ namespace suborbital
 {
     // Forward declarations.
     class Entity;
+    class ComponentRegistry;
+    class MemoryPool;
 
     /**
      * The base class for components attachable to entities.
@@ -16,6 +18,7 @@ namespace suborbital
     class Component : public Watchable, private NonCopyable
     {
     friend Entity;
+    friend ComponentRegistry;
     public:
         /**
          * Destructor.
@@ -45,6 +48,12 @@ namespace suborbital
          * Pointer to the parent entity.
          */
         WatchPtr<Entity> m_entity;
+
+        /**
+         * Pool from which the component's memory was allocated (will be a nullptr if the component was allocated
+         * using `new`).
+         */
+        MemoryPool* m_pool;
     };
 }
 
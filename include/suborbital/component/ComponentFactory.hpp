@@ -10,6 +10,22 @@ namespace suborbital
     // Forward declarations.
     class Component;
 
+    /**
+     * Deleter for components created by component factories.
+     *
+     * Components are destroyed through `ComponentRegistry::destroy_component`, which returns pooled components to the
+     * pool that they were allocated from.
+     */
+    struct ComponentDeleter
+    {
+        /**
+         * Destroys the supplied `component`.
+         *
+         * @param component Pointer to the component to destroy (may be a nullptr).
+         */
+        void operator()(Component* component) const;
+    };
+
     /**
      * The base class for factories that instantiate components.
      */
@@ -29,9 +45,9 @@ namespace suborbital
         /**
          * Instantiates a component and returns a unique_ptr to the created component.
          *
-         * @return Unique pointer to the created component.
+         * @return Unique pointer to the created component, which destroys the component through the component registry.
          */
-        virtual std::unique_ptr<Component> create() const = 0;
+        virtual std::unique_ptr<Component, ComponentDeleter> create() const = 0;
     };
 }
 
@@ -5,13 +5,19 @@
 #include <memory>
 #include <cassert>
 #include <unordered_map>
+#include <vector>
 #include <typeindex>
+#include <new>
 
 #include <suborbital/NonCopyable.hpp>
+#include <suborbital/MemoryPool.hpp>
 #include "ComponentFactory.hpp"
+#include "Component.hpp"
 
 /**
- * Macro for associating a string name to a c++ type.
+ * Macro for associating a string name and an integer identifier to a c++ type.
+ *
+ * The identifier is assigned by the component registry the first time that it is requested and is cached thereafter.
  *
  * @param T Type to be associated with a string of the same name.
  */
@@ -24,6 +30,12 @@ namespace suborbital
         static std::string name()                                                                                      \
         {                                                                                                              \
             return #T;                                                                                                 \
+        }                                                                                                              \
+                                                                                                                       \
+        static ComponentTypeId id()                                                                                    \
+        {                                                                                                              \
+            static const ComponentTypeId type_id = component_registry().type_id(#T);                                   \
+            return type_id;                                                                                            \
         }                                                                                                              \
     };                                                                                                                 \
 }                                                                                                                      \
@@ -37,7 +49,15 @@ namespace suborbital
     class Behaviour;
 
     /**
-     * Type naming system used for associating string names to c++ types.
+     * Dense integer identifier for a component type.
+     *
+     * Identifiers are assigned by the component registry, starting from zero, and are used to index the component
+     * storage in place of class names.
+     */
+    typedef std::size_t ComponentTypeId;
+
+    /**
+     * Type naming system used for associating string names and integer identifiers to c++ types.
      *
      * The `TYPE` macro will generate a specialisation of the `TypeName` template class for the provided type.
      * Note that this is done automatically when using the `REGISTER_ATTRIBUTE` and `REGISTER_BEHAVIOUR` macros.
@@ -49,18 +69,34 @@ namespace suborbital
         {
             assert(0); // Specialisation for `T` has not been provided.
         }
+
+        static ComponentTypeId id()
+        {
+            assert(0); // Specialisation for `T` has not been provided.
+        }
     };
 
     /**
      * Component registry.
+     *
+     * In addition to the component factories, the registry owns a memory pool for each c++ component type.
+     * Components created through `create_component` are allocated from the pool for their type and must be destroyed
+     * through `destroy_component`, which returns their memory to the pool for reuse.
      */
     class ComponentRegistry : public NonCopyable
     {
     private:
+        /**
+         * Component type identifiers registry type definition.
+         */
+        typedef std::unordered_map<std::string, ComponentTypeId> TypeRegistry;
+
         /**
          * Component factories registry type definition.
+         *
+         * Factories are indexed by component type identifier.
          */
-        typedef std::unordered_map<std::string, std::unique_ptr<ComponentFactory>> FactoryRegistry;
+        typedef std::vector<std::unique_ptr<ComponentFactory>> FactoryRegistry;
 
     public:
         /**
@@ -84,7 +120,7 @@ namespace suborbital
             static_assert(std::is_base_of<Component, ComponentType>::value, "Template parameter ComponentType in"
                     " ComponentRegistry::register_component is not derived from Component");
 
-            m_factory_registry.insert(FactoryRegistry::value_type(Type<ComponentType>::name(), std::move(factory)));
+            register_component(Type<ComponentType>::id(), std::move(factory));
         }
 
         /**
@@ -98,57 +134,218 @@ namespace suborbital
          */
         void register_component(const std::string& name, std::unique_ptr<ComponentFactory> factory);
 
+        /**
+         * Returns the identifier for the component type with the specified class name.
+         *
+         * An identifier is assigned the first time that a class name is encountered. Identifiers are dense and start
+         * from zero, which makes them suitable for use as array indices. This function should only be used when
+         * registering or creating components; use `find_type_id` for lookups.
+         *
+         * @param name Class name for the component type.
+         * @return Identifier for the component type.
+         */
+        ComponentTypeId type_id(const std::string& name);
+
+        /**
+         * Looks up the identifier for the component type with the specified class name, without assigning a new
+         * identifier.
+         *
+         * Lookups that do not register or create components should use this function, so that unknown class names do
+         * not consume identifiers.
+         *
+         * @param name Class name for the component type.
+         * @return Identifier for the component type, or `npos` if the class name has not been encountered.
+         */
+        ComponentTypeId find_type_id(const std::string& name) const;
+
+        /**
+         * Returns the number of component type identifiers that have been assigned.
+         *
+         * @return Number of component types.
+         */
+        std::size_t type_count() const;
+
         /**
          * Creates and returns an instance of the attribute registered to the provided attribute name.
          *
          * @param name Name of the attribute for which to create.
-         * @return Instance of the attribute associated with the specified attribute name.
+         * @return Instance of the attribute associated with the specified attribute name, or a nullptr if no
+         * attribute could be created.
          */
-        std::unique_ptr<Attribute> create_attribute(const std::string& name) const;
+        std::unique_ptr<Attribute, ComponentDeleter> create_attribute(const std::string& name) const;
 
         /**
          * Creates and returns an instance of the attribute registered to the provided attribute type.
          *
-         * @return Instance of the attribute associated with the provided attribute type.
+         * @return Instance of the attribute associated with the provided attribute type, or a nullptr if no attribute
+         * of the type could be created.
          */
         template<typename AttributeType>
-        std::unique_ptr<AttributeType> create_attribute() const
+        std::unique_ptr<AttributeType, ComponentDeleter> create_attribute() const
         {
             static_assert(std::is_base_of<Attribute, AttributeType>::value, "Template parameter AttributeType in"
                     " ComponentRegistry::create_attribute is not derived from Attribute");
 
-            return std::dynamic_pointer_cast<std::unique_ptr<AttributeType>>(create_attribute(Type<AttributeType>::name()));
+            // The attribute is cast whilst it is still owned, so that it is destroyed if the cast fails.
+            std::unique_ptr<Attribute, ComponentDeleter> attribute = create_attribute(Type<AttributeType>::name());
+            AttributeType* specific_attribute = dynamic_cast<AttributeType*>(attribute.get());
+            if (specific_attribute == nullptr)
+            {
+                return nullptr;
+            }
+
+            attribute.release();
+            return std::unique_ptr<AttributeType, ComponentDeleter>(specific_attribute);
         }
 
         /**
          * Creates and returns an instance of the behaviour registered to the provided behaviour name.
          *
          * @param name Name of the behaviour for which to create.
-         * @return Instance of the behaviour associated with the specified behaviour name.
+         * @return Instance of the behaviour associated with the specified behaviour name, or a nullptr if no
+         * behaviour could be created.
          */
-        std::unique_ptr<Behaviour> create_behaviour(const std::string& name) const;
+        std::unique_ptr<Behaviour, ComponentDeleter> create_behaviour(const std::string& name) const;
 
         /**
          * Creates and returns an instance of the behaviour registered to the provided behaviour type.
          *
-         * @return Instance of the behaviour associated with the provided behaviour type.
+         * @return Instance of the behaviour associated with the provided behaviour type, or a nullptr if no behaviour
+         * of the type could be created.
          */
         template<typename BehaviourType>
-        std::unique_ptr<BehaviourType> create_behaviour() const
+        std::unique_ptr<BehaviourType, ComponentDeleter> create_behaviour() const
         {
-            static_assert(std::is_base_of<Attribute, BehaviourType>::value, "Template parameter BehaviourType in"
+            static_assert(std::is_base_of<Behaviour, BehaviourType>::value, "Template parameter BehaviourType in"
                     " ComponentRegistry::create_behaviour is not derived from Behaviour");
 
-            return std::dynamic_pointer_cast<std::unique_ptr<BehaviourType>>(create_behaviour(Type<BehaviourType>::name()));
+            // The behaviour is cast whilst it is still owned, so that it is destroyed if the cast fails.
+            std::unique_ptr<Behaviour, ComponentDeleter> behaviour = create_behaviour(Type<BehaviourType>::name());
+            BehaviourType* specific_behaviour = dynamic_cast<BehaviourType*>(behaviour.get());
+            if (specific_behaviour == nullptr)
+            {
+                return nullptr;
+            }
+
+            behaviour.release();
+            return std::unique_ptr<BehaviourType, ComponentDeleter>(specific_behaviour);
+        }
+
+        /**
+         * Creates a component of the templated type, allocating it from the pool for that type.
+         *
+         * @note The returned component must be destroyed using `destroy_component`.
+         *
+         * @return Pointer to the created component.
+         */
+        template<typename ComponentType>
+        ComponentType* create_component()
+        {
+            static_assert(std::is_base_of<Component, ComponentType>::value, "Template parameter ComponentType in"
+                    " ComponentRegistry::create_component is not derived from Component");
+
+            MemoryPool& memory_pool = pool(Type<ComponentType>::id(), sizeof(ComponentType), alignof(ComponentType));
+            void* block = memory_pool.allocate();
+
+            ComponentType* component;
+            try
+            {
+                component = new (block) ComponentType();
+            }
+            catch (...)
+            {
+                memory_pool.deallocate(block);
+                throw;
+            }
+
+            Component* base = component;
+            base->m_pool = &memory_pool;
+            return component;
         }
 
+        /**
+         * Destroys the supplied `component`.
+         *
+         * Components allocated from a pool have their memory returned to the pool, whereas all other components
+         * (such as those instantiated by scripts) are deleted.
+         *
+         * @param component Pointer to the component to destroy.
+         */
+        void destroy_component(Component* component);
+
+        /**
+         * Returns the memory pool for the component type with the specified identifier.
+         *
+         * The pool provides occupancy and high-water-mark statistics for the components of the type.
+         *
+         * @param type Identifier for the component type.
+         * @return Pointer to the pool, or a nullptr if no component of the type has been allocated from a pool.
+         */
+        const MemoryPool* component_pool(ComponentTypeId type) const;
+
+        /**
+         * Returns the memory pool for the templated component type.
+         *
+         * @return Pointer to the pool, or a nullptr if no component of the type has been allocated from a pool.
+         */
+        template<typename ComponentType>
+        const MemoryPool* component_pool() const
+        {
+            return component_pool(Type<ComponentType>::id());
+        }
+
+        /**
+         * Value returned by `find_type_id` for class names that have not been encountered.
+         */
+        static const ComponentTypeId npos;
+
     private:
+        /**
+         * Registers the supplied component factory to the specified component type identifier.
+         *
+         * @param type Identifier for the component type.
+         * @param factory Factory to use for instantiating components of the specified type.
+         */
+        void register_component(ComponentTypeId type, std::unique_ptr<ComponentFactory> factory);
+
+        /**
+         * Returns the factory registered to the specified component type identifier.
+         *
+         * @param type Identifier for the component type.
+         * @return Pointer to the factory, or a nullptr if no factory has been registered.
+         */
+        ComponentFactory* factory(ComponentTypeId type) const;
+
+        /**
+         * Returns the memory pool for the component type with the specified identifier, creating it if it does not
+         * already exist.
+         *
+         * @param type Identifier for the component type.
+         * @param size Size (in bytes) of the component type.
+         * @param alignment Alignment (in bytes) of the component type.
+         * @return Reference to the pool.
+         */
+        MemoryPool& pool(ComponentTypeId type, std::size_t size, std::size_t alignment);
+
+    private:
+        /**
+         * Component type identifier registry.
+         *
+         * Maps component class names to their identifiers.
+         */
+        TypeRegistry m_type_registry;
+
         /**
          * Component factory registry.
          *
-         * Maps components by name to their factory instances.
+         * Maps component type identifiers to their factory instances.
          */
         FactoryRegistry m_factory_registry;
+
+        /**
+         * Component memory pools, indexed by component type identifier.
+         */
+        std::vector<std::unique_ptr<MemoryPool>> m_pools;
     };
 
     /**
@@ -43,7 +43,7 @@ namespace suborbital
          *
          * @return Unique pointer to the created Python attribute.
          */
-        std::unique_ptr<Component> create() const
+        std::unique_ptr<Component, ComponentDeleter> create() const
         {
             // The Python interpreter better be initialized.
             assert(Py_IsInitialized());
@@ -121,7 +121,7 @@ namespace suborbital
             Py_XDECREF(python_class);
 
             // Return a unique pointer to the scripted Python attribute.
-            return std::unique_ptr<PythonAttribute>(scripted_attribute_ptr);
+            return std::unique_ptr<Component, ComponentDeleter>(scripted_attribute_ptr);
         }
 
     private:
@@ -43,7 +43,7 @@ namespace suborbital
          *
          * @return Unique pointer to the created Python behaviour.
          */
-        std::unique_ptr<Component> create() const
+        std::unique_ptr<Component, ComponentDeleter> create() const
         {
             // Import the script file.
             PyObject* module = PyImport_ImportModule(m_class_name.c_str());
@@ -118,7 +118,7 @@ namespace suborbital
             Py_XDECREF(python_class);
 
             // Return a unique pointer to the scripted Python behaviour.
-            return std::unique_ptr<PythonBehaviour>(scripted_behaviour_ptr);
+            return std::unique_ptr<Component, ComponentDeleter>(scripted_behaviour_ptr);
         }
 
     private:
@@ -0,0 +1,122 @@
+#ifndef SUBORBITAL_CONCURRENT_EVENT_QUEUE_HPP
+#define SUBORBITAL_CONCURRENT_EVENT_QUEUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <suborbital/NonCopyable.hpp>
+#include <suborbital/EntityHandle.hpp>
+
+#include <suborbital/event/EventSubscription.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class Event;
+
+    /**
+     * Lock-free queue of events posted from any number of threads, for delivery on the thread that processes the scene.
+     *
+     * Posting an event pushes it onto an atomic singly linked list with a single compare-and-swap, so producers never
+     * block one another or the consumer. The consumer detaches the whole list with a single exchange and restores the
+     * order in which the events were posted.
+     *
+     * Event types are resolved by the consumer, since the event type registry may only be accessed from the thread
+     * that processes the scene.
+     */
+    class ConcurrentEventQueue : private NonCopyable
+    {
+    public:
+        /**
+         * Event posted to the queue.
+         */
+        struct Post
+        {
+            /**
+             * Entity to publish the event to, or a null handle to publish the event to the scene.
+             */
+            EntityHandle entity;
+
+            /**
+             * Function that looks up the event type identifier, or a nullptr to look it up by `event_name`.
+             */
+            EventTypeId (*event_type)();
+
+            /**
+             * Name of the event, if `event_type` is a nullptr.
+             */
+            std::string event_name;
+
+            /**
+             * Shared pointer to the event.
+             */
+            std::shared_ptr<Event> event;
+        };
+
+    public:
+        /**
+         * Constructor.
+         */
+        ConcurrentEventQueue();
+
+        /**
+         * Destructor.
+         *
+         * Events that have not been drained are discarded.
+         */
+        ~ConcurrentEventQueue();
+
+        /**
+         * Adds an event to the queue.
+         *
+         * This function may be called from any thread.
+         *
+         * @param post Event to add.
+         */
+        void push(Post post);
+
+        /**
+         * Removes all of the queued events, appending them to `posts` in the order that they were pushed. Events
+         * pushed by a single thread are kept in the order that the thread pushed them.
+         *
+         * This function must only be called by one thread at a time.
+         *
+         * @param posts Vector to append the events to.
+         */
+        void drain(std::vector<Post>& posts);
+
+        /**
+         * Checks whether the queue is empty.
+         *
+         * @return True if no events are queued, false otherwise.
+         */
+        bool empty() const;
+
+    private:
+        /**
+         * Node in the linked list of queued events.
+         */
+        struct Node
+        {
+            /**
+             * Queued event.
+             */
+            Post post;
+
+            /**
+             * The node pushed before this one, or a nullptr.
+             */
+            Node* next;
+        };
+
+    private:
+        /**
+         * The most recently pushed node, or a nullptr if the queue is empty.
+         */
+        std::atomic<Node*> m_head;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,142 @@
+#ifndef SUBORBITAL_EVENT_ALLOCATOR_HPP
+#define SUBORBITAL_EVENT_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <suborbital/MemoryPool.hpp>
+
+namespace suborbital
+{
+    /**
+     * Allocator that takes single objects from a memory pool shared by all allocators of the same type.
+     *
+     * Intended for use with `std::allocate_shared` (see `make_event`), which rebinds the allocator to a type that holds
+     * both the event and the shared pointer's control block. Each event type therefore draws from its own pool of
+     * fixed-size blocks, and publishing an event does not touch the system allocator once the pool has grown large
+     * enough to hold the events that are alive at any one time.
+     *
+     * @note The pools are not thread-safe. Pooled events must be created and released on the thread that processes the
+     * scene.
+     */
+    template<typename T>
+    class EventAllocator
+    {
+    public:
+        typedef T value_type;
+
+    public:
+        /**
+         * Constructor.
+         */
+        EventAllocator() noexcept
+        {
+            // Nothing to do.
+        }
+
+        /**
+         * Converting constructor.
+         *
+         * @param other The allocator to convert from.
+         */
+        template<typename U>
+        EventAllocator(const EventAllocator<U>& other) noexcept
+        {
+            // Nothing to do.
+        }
+
+        /**
+         * Allocates storage for `n` objects.
+         *
+         * Single objects are taken from the pool. Arrays are obtained from the system.
+         *
+         * @param n Number of objects.
+         * @return Pointer to the uninitialised storage.
+         */
+        T* allocate(std::size_t n)
+        {
+            if (n != 1)
+            {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+
+            return static_cast<T*>(pool().allocate());
+        }
+
+        /**
+         * Releases storage previously obtained from `allocate`.
+         *
+         * @param object Pointer to the storage.
+         * @param n Number of objects that the storage was allocated for.
+         */
+        void deallocate(T* object, std::size_t n)
+        {
+            if (n != 1)
+            {
+                ::operator delete(object);
+                return;
+            }
+
+            pool().deallocate(object);
+        }
+
+        /**
+         * Equality operator.
+         *
+         * Allocators of the same type share a pool, so storage allocated by one may be released by any other.
+         *
+         * @param other The other allocator to compare with.
+         * @return True.
+         */
+        template<typename U>
+        bool operator==(const EventAllocator<U>& other) const noexcept
+        {
+            return true;
+        }
+
+        /**
+         * Inequality operator.
+         *
+         * @param other The other allocator to compare with.
+         * @return False.
+         */
+        template<typename U>
+        bool operator!=(const EventAllocator<U>& other) const noexcept
+        {
+            return false;
+        }
+
+    private:
+        /**
+         * Accessor for the pool shared by all allocators of this type.
+         *
+         * The pool is never destroyed, since events may be held by objects that outlive the static objects.
+         *
+         * @return Reference to the pool.
+         */
+        static MemoryPool& pool()
+        {
+            static MemoryPool* memory = new MemoryPool(sizeof(T), alignof(T), 64);
+            return *memory;
+        }
+    };
+
+    /**
+     * Constructs an event of the templated type in pooled memory.
+     *
+     * The event and its shared pointer control block are allocated together in a single block (see `EventAllocator`),
+     * so this is cheaper than `std::make_shared` for events that are published frequently.
+     *
+     * @param args Arguments to forward to the event's constructor.
+     * @return Shared pointer to the event.
+     */
+    template<typename EventType, typename... Args>
+    std::shared_ptr<EventType> make_event(Args&&... args)
+    {
+        return std::allocate_shared<EventType>(EventAllocator<EventType>(), std::forward<Args>(args)...);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <memory>
 #include <functional>
 
+#include <suborbital/event/Event.hpp>
 #include <suborbital/event/EventCallbackBase.hpp>
 
 namespace suborbital
@@ -57,13 +58,14 @@ namespace suborbital
 
         /**
          * Executes the callback function.
+         *
+         * Events are dispatched by type identifier (or by a name that matches the event's class name), so the event is
+         * known to be of the callback's event type and is cast statically. The cast is checked in debug builds.
          */
-        void operator()(std::shared_ptr<Event> event)
+        void operator()(const std::shared_ptr<Event>& event)
         {
-            std::shared_ptr<EventType> derived_event = std::dynamic_pointer_cast<EventType>(event);
-            assert(derived_event != nullptr);
-
-            m_callback_function(derived_event);
+            assert(dynamic_cast<EventType*>(event.get()) != nullptr);
+            m_callback_function(std::static_pointer_cast<EventType>(event));
         }
 
     private:
@@ -2,6 +2,7 @@
 #define SUBORBITAL_EVENT_CALLBACK_BASE_HPP
 
 #include <memory>
+#include <vector>
 
 namespace suborbital
 {
@@ -26,7 +27,24 @@ namespace suborbital
          *
          * @param event Shared pointer to the event that is handled by the wrapped callback function.
          */
-        virtual void operator()(std::shared_ptr<Event> event) = 0;
+        virtual void operator()(const std::shared_ptr<Event>& event) = 0;
+
+        /**
+         * Executes the wrapped callback function for a batch of events.
+         *
+         * This function is called for subscriptions with `EventDelivery::Batched` delivery. The default implementation
+         * executes the callback function once for each event in turn.
+         *
+         * @param events Shared pointers to the events, in the order that they were published.
+         */
+        virtual void handle_batch(const std::vector<std::shared_ptr<Event>>& events);
+
+        /**
+         * Whether the wrapped callback function is implemented in a scripting language.
+         *
+         * @return False, unless overridden by a derived class.
+         */
+        virtual bool scripted() const;
 
     protected:
         /**
@@ -3,30 +3,61 @@
 
 #include <string>
 #include <memory>
+#include <cassert>
 #include <functional>
-#include <map>
-#include <unordered_map>
+#include <vector>
 
 #include <suborbital/NonCopyable.hpp>
 #include <suborbital/Watchable.hpp>
 
+#include <suborbital/event/EventAllocator.hpp>
+#include <suborbital/event/EventCallback.hpp>
+#include <suborbital/event/EventSubscriber.hpp>
+#include <suborbital/event/EventSubscription.hpp>
+
+#include <suborbital/component/ComponentRegistry.hpp>
+
 namespace suborbital
 {
     // Forward declarations.
     class Event;
     class EventSubscription;
     class EventCallbackBase;
+    class EventQueue;
+    class SubscriptionObserver;
 
-    // Type definitions.
-    namespace
+    /**
+     * Policies for collapsing events of the same type that are queued for deferred delivery by a dispatcher.
+     */
+    enum class EventCoalescing
     {
         /**
-         * Map from event subscriptions to callbacks.
-         *
-         * Note that we map from `EventSubscription` pointers since subscriptions are unique and non-copyable.
+         * Every published event is delivered.
+         */
+        None,
+
+        /**
+         * Only the first event published before the queue is delivered is kept.
+         */
+        KeepFirst,
+
+        /**
+         * Only the last event published before the queue is delivered is kept.
          */
-        typedef std::map<EventSubscription* const, std::unique_ptr<EventCallbackBase>> SubscriptionMap;
-    }
+        KeepLast,
+
+        /**
+         * Events are combined into a single event by a merge function.
+         */
+        Merge
+    };
+
+    /**
+     * Function that combines an event queued for deferred delivery with an event of the same type that is
+     * subsequently published. The returned event replaces the queued event, and must not be a nullptr.
+     */
+    typedef std::function<std::shared_ptr<Event>(const std::shared_ptr<Event>& queued,
+            const std::shared_ptr<Event>& published)> EventMerge;
 
     /**
      * Event dispatcher.
@@ -44,15 +75,38 @@ namespace suborbital
      * It is the responsibility of any C++ defined callback functions to cast the received event shared pointer to the
      * correct type. Event type inference is handled automatically by the scripting system for Python defined callback
      * functions.
+     *
+     * C++ code should prefer the typed `publish` and `subscribe` overloads. These look up the event type identifier
+     * once per type, rather than hashing the event name on every call, and deliver events to `EventCallback`'s without
+     * a dynamic cast. Typed events require a `TYPE` declaration for the event class. Events that are published
+     * frequently should be created using `make_event`, which allocates them from a pool.
+     *
+     * Subscribers choose whether events are delivered immediately or deferred (see `EventDelivery`). Deferred events
+     * are held in per-type queues by the dispatcher until the `EventQueue` that the dispatcher belongs to delivers
+     * them. Subscribers with batched delivery receive all of the queued events of one type in a single call to
+     * `EventCallbackBase::handle_batch`; the typed `subscribe` overload delivers batched events one at a time.
+     * Dispatchers that do not belong to an event queue deliver all events immediately.
+     *
+     * Subscribers are stored contiguously for each event type. Subscriptions may be created and cancelled by callbacks
+     * whilst events are being dispatched. Subscriptions created during dispatch do not receive the event that is being
+     * dispatched. Subscriptions cancelled during dispatch receive no further events.
+     *
+     * Event types may be configured to coalesce (see `coalesce`). Events of a coalescing type that are published
+     * to a dispatcher before its queue is delivered collapse into a single queued event, so that each deferred
+     * subscriber receives at most one such event per delivery. Immediate subscribers receive every event.
      */
     class EventDispatcher : public Watchable, private NonCopyable
     {
     friend EventSubscription;
+    friend EventQueue;
     public:
         /**
          * Constructor.
+         *
+         * @param queue Event queue that delivers the dispatcher's deferred events (may be a nullptr).
+         * @param observer Object to notify when event types gain or lose all of their subscribers (may be a nullptr).
          */
-        EventDispatcher();
+        EventDispatcher(EventQueue* queue = nullptr, SubscriptionObserver* observer = nullptr);
 
         /**
          * Destructor.
@@ -65,18 +119,286 @@ namespace suborbital
          * @param event_name Name of the event to publish.
          * @param Shared pointer to the event to be published.
          */
-        void publish(const std::string& event_name, std::shared_ptr<Event> event);
+        void publish(const std::string& event_name, const std::shared_ptr<Event>& event);
+
+        /**
+         * Publishes an event to be dispatched to all subscribers of the specified event type.
+         *
+         * @param event_type Identifier for the event type.
+         * @param Shared pointer to the event to be published.
+         */
+        void publish(EventTypeId event_type, const std::shared_ptr<Event>& event);
+
+        /**
+         * Publishes an event to be dispatched to all subscribers of the event's type.
+         *
+         * @param Shared pointer to the event to be published.
+         */
+        template<typename EventType>
+        void publish(const std::shared_ptr<EventType>& event)
+        {
+            publish(event_type<EventType>(), event);
+        }
 
         /**
          * Subscribes to receive events of the specified `event_name`.
          *
          * @param event_name Name of the event to subscribe for.
          * @param callback Callback function that should receive the events.
+         * @param delivery When events should be delivered to the callback.
+         * @return Subscription object that controls the lifetime of the subscription.
+         */
+        std::unique_ptr<EventSubscription> subscribe(const std::string& event_name, std::unique_ptr<EventCallbackBase> callback,
+                EventDelivery delivery = EventDelivery::Immediate);
+
+        /**
+         * Subscribes to receive events of the specified event type.
+         *
+         * @param event_type Identifier for the event type.
+         * @param callback Callback function that should receive the events.
+         * @param delivery When events should be delivered to the callback.
+         * @return Subscription object that controls the lifetime of the subscription.
+         */
+        std::unique_ptr<EventSubscription> subscribe(EventTypeId event_type, std::unique_ptr<EventCallbackBase> callback,
+                EventDelivery delivery = EventDelivery::Immediate);
+
+        /**
+         * Subscribes to receive events of the templated type.
+         *
+         * @param callback_function Function that should receive the events.
+         * @param delivery When events should be delivered to the callback.
          * @return Subscription object that controls the lifetime of the subscription.
          */
-        std::unique_ptr<EventSubscription> subscribe(const std::string& event_name, std::unique_ptr<EventCallbackBase> callback);
+        template<typename EventType>
+        std::unique_ptr<EventSubscription> subscribe(const std::function<void(std::shared_ptr<EventType>)>& callback_function,
+                EventDelivery delivery = EventDelivery::Immediate)
+        {
+            // The function is stored inline by the subscriber, and the event is cast statically as for `EventCallback`.
+            std::function<void(std::shared_ptr<EventType>)> function(callback_function);
+            return subscribe(event_type<EventType>(), EventSubscriber([function](const std::shared_ptr<Event>& event)
+            {
+                assert(dynamic_cast<EventType*>(event.get()) != nullptr);
+                function(std::static_pointer_cast<EventType>(event));
+            }), delivery);
+        }
+
+        /**
+         * Looks up the identifier for the specified event name, assigning a new identifier if the name has not been
+         * used before.
+         *
+         * @param event_name Name of the event.
+         * @return Identifier for the event type.
+         */
+        static EventTypeId event_type(const std::string& event_name);
+
+        /**
+         * Looks up the identifier for the templated event type.
+         *
+         * The identifier is looked up the first time that it is requested and is cached thereafter.
+         *
+         * @return Identifier for the event type.
+         */
+        template<typename EventType>
+        static EventTypeId event_type()
+        {
+            static const EventTypeId type = event_type(Type<EventType>::name());
+            return type;
+        }
+
+        /**
+         * Looks up the identifier for the specified event name, without assigning a new identifier.
+         *
+         * @param event_name Name of the event.
+         * @return Identifier for the event type, or `no_event_type` if the name has not been used.
+         */
+        static EventTypeId find_event_type(const std::string& event_name);
+
+        /**
+         * Looks up the event name for the specified event type identifier.
+         *
+         * This function has time complexity linear in the number of event names that have been used, O(n).
+         *
+         * @param event_type Identifier for the event type.
+         * @return Name of the event, or the empty string if the identifier has not been assigned.
+         */
+        static std::string event_name(EventTypeId event_type);
+
+        /**
+         * Sets the coalescing policy for the specified event type, for all dispatchers.
+         *
+         * Policies should be set before events of the type are published. Use the overload taking an `EventMerge`
+         * function to merge events.
+         *
+         * @param event_type Identifier for the event type.
+         * @param coalescing Coalescing policy.
+         */
+        static void coalesce(EventTypeId event_type, EventCoalescing coalescing);
+
+        /**
+         * Sets the function used to merge events of the specified event type, for all dispatchers.
+         *
+         * @param event_type Identifier for the event type.
+         * @param merge Function that combines queued and published events.
+         */
+        static void coalesce(EventTypeId event_type, const EventMerge& merge);
+
+        /**
+         * Sets the coalescing policy for the templated event type, for all dispatchers.
+         *
+         * @param coalescing Coalescing policy.
+         */
+        template<typename EventType>
+        static void coalesce(EventCoalescing coalescing)
+        {
+            coalesce(event_type<EventType>(), coalescing);
+        }
+
+        /**
+         * Sets the function used to merge events of the templated event type, for all dispatchers.
+         *
+         * @param merge_function Function that combines queued and published events.
+         */
+        template<typename EventType>
+        static void coalesce(const std::function<std::shared_ptr<EventType>(const std::shared_ptr<EventType>&,
+                const std::shared_ptr<EventType>&)>& merge_function)
+        {
+            std::function<std::shared_ptr<EventType>(const std::shared_ptr<EventType>&,
+                    const std::shared_ptr<EventType>&)> function(merge_function);
+            coalesce(event_type<EventType>(), EventMerge([function](const std::shared_ptr<Event>& queued,
+                    const std::shared_ptr<Event>& published) -> std::shared_ptr<Event>
+            {
+                assert(dynamic_cast<EventType*>(queued.get()) != nullptr);
+                assert(dynamic_cast<EventType*>(published.get()) != nullptr);
+                return function(std::static_pointer_cast<EventType>(queued), std::static_pointer_cast<EventType>(published));
+            }));
+        }
+
+        /**
+         * Accessor for the coalescing policy of the specified event type.
+         *
+         * @param event_type Identifier for the event type.
+         * @return Coalescing policy, which is `EventCoalescing::None` unless otherwise set.
+         */
+        static EventCoalescing coalescing(EventTypeId event_type);
+
+        /**
+         * Value returned by `find_event_type` for event names that have not been used.
+         */
+        static const EventTypeId no_event_type;
+
+    private:
+        /**
+         * Subscribers for one type of event.
+         */
+        struct SubscriberList
+        {
+            /**
+             * Subscribers, in the order that they subscribed, including tombstones for cancelled subscriptions.
+             */
+            std::vector<EventSubscriber> subscribers;
+
+            /**
+             * Subscribers that subscribed whilst events were being dispatched. These are appended to `subscribers` once
+             * dispatch has finished.
+             */
+            std::vector<EventSubscriber> pending;
+
+            /**
+             * Number of tombstones amongst the subscribers.
+             */
+            std::size_t tombstones;
+
+            /**
+             * Whether the list has pending subscribers or tombstones that were added during dispatch.
+             */
+            bool dirty;
+        };
 
     private:
+        /**
+         * Adds a subscriber for the specified event type.
+         *
+         * @param event_type Identifier for the event type.
+         * @param subscriber Subscriber holding the callback function.
+         * @param delivery When events should be delivered to the subscriber.
+         * @return Subscription object that controls the lifetime of the subscription.
+         */
+        std::unique_ptr<EventSubscription> subscribe(EventTypeId event_type, EventSubscriber subscriber,
+                EventDelivery delivery);
+
+        /**
+         * Accessor for the subscriber lists for the specified mode of delivery.
+         *
+         * @param delivery When events are delivered to the subscribers.
+         * @return Reference to the subscriber lists, indexed by event type identifier.
+         */
+        std::vector<SubscriberList>& subscriber_lists(EventDelivery delivery);
+
+        /**
+         * Calls all of the active subscribers for the specified event type that existed when dispatch began.
+         *
+         * @param lists Subscriber lists, indexed by event type identifier.
+         * @param event_type Identifier for the event type.
+         * @param event Shared pointer to the event.
+         * @return Number of callbacks that were called.
+         */
+        std::size_t dispatch(std::vector<SubscriberList>& lists, EventTypeId event_type, const std::shared_ptr<Event>& event);
+
+        /**
+         * Calls the supplied `subscriber`, recording the time taken if event statistics are enabled.
+         *
+         * @param subscriber Active subscriber.
+         * @param event_type Identifier for the event type.
+         * @param event Shared pointer to the event.
+         */
+        static void call(EventSubscriber& subscriber, EventTypeId event_type, const std::shared_ptr<Event>& event);
+
+        /**
+         * Calls the supplied batched `subscriber` with all of the `events`, recording the time taken if event
+         * statistics are enabled.
+         *
+         * @param subscriber Active subscriber that handles batches of events.
+         * @param event_type Identifier for the event type.
+         * @param events Shared pointers to the events.
+         */
+        static void call(EventSubscriber& subscriber, EventTypeId event_type, const std::vector<std::shared_ptr<Event>>& events);
+
+        /**
+         * Marks the start of dispatch.
+         */
+        void begin_dispatch();
+
+        /**
+         * Marks the end of dispatch. Once the outermost dispatch has finished, the subscribers that subscribed during
+         * dispatch are added, the callbacks of the tombstones are destroyed and tombstones are removed from the lists
+         * that were modified.
+         */
+        void end_dispatch();
+
+        /**
+         * Removes the tombstones from the supplied subscriber `list`, if they make up at least half of the list.
+         *
+         * @param list Subscriber list.
+         */
+        static void compact(SubscriberList& list);
+
+        /**
+         * Checks whether there are any active subscribers for the specified event type.
+         *
+         * @param lists Subscriber lists, indexed by event type identifier.
+         * @param event_type Identifier for the event type.
+         * @return True if there is at least one active subscriber, false otherwise.
+         */
+        static bool has_subscribers(const std::vector<SubscriberList>& lists, EventTypeId event_type);
+
+        /**
+         * Checks whether there are any active subscribers for the specified event type, for either mode of delivery.
+         *
+         * @param event_type Identifier for the event type.
+         * @return True if there is at least one active subscriber, false otherwise.
+         */
+        bool has_subscribers(EventTypeId event_type) const;
+
         /**
          * Cancels a subscription.
          *
@@ -87,13 +409,61 @@ namespace suborbital
          */
         void unsubscribe(EventSubscription* subscription);
 
+        /**
+         * Delivers all of the queued events to the deferred subscribers.
+         *
+         * This function is called exclusively by the `EventQueue` class.
+         */
+        void deliver();
+
     private:
         /**
-         * Event subscriptions.
+         * Event queue that delivers the dispatcher's deferred events (may be a nullptr).
+         */
+        EventQueue* m_queue;
+
+        /**
+         * Object to notify when event types gain or lose all of their subscribers (may be a nullptr).
+         */
+        SubscriptionObserver* m_observer;
+
+        /**
+         * Subscribers for immediate delivery, indexed by event type identifier.
+         */
+        std::vector<SubscriberList> m_subscriptions;
+
+        /**
+         * Subscribers for deferred delivery, indexed by event type identifier.
+         */
+        std::vector<SubscriberList> m_deferred_subscriptions;
+
+        /**
+         * Subscriber lists that were modified during dispatch, as pairs of delivery mode and event type identifier.
+         */
+        std::vector<std::pair<EventDelivery, EventTypeId>> m_dirty;
+
+        /**
+         * Depth of nested dispatch. Subscriber lists are only reorganised when this is zero.
+         */
+        std::size_t m_dispatching;
+
+        /**
+         * Events awaiting deferred delivery, indexed by event type identifier.
+         */
+        std::vector<std::vector<std::shared_ptr<Event>>> m_queued;
+
+        /**
+         * Events being delivered, indexed by event type identifier.
          *
-         * Maps event names to a map from event subscriptions to callback pointers.
+         * The queued and delivering events are swapped at the start of each delivery, so that events published during
+         * the delivery are queued for the next delivery.
+         */
+        std::vector<std::vector<std::shared_ptr<Event>>> m_delivering;
+
+        /**
+         * Whether the dispatcher is scheduled with its event queue.
          */
-        std::unordered_map<std::string, SubscriptionMap> m_subscriptions;
+        bool m_scheduled;
     };
 }
 
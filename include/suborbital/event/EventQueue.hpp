@@ -0,0 +1,68 @@
+#ifndef SUBORBITAL_EVENT_QUEUE_HPP
+#define SUBORBITAL_EVENT_QUEUE_HPP
+
+#include <vector>
+
+#include <suborbital/NonCopyable.hpp>
+#include <suborbital/WatchPtr.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class EventDispatcher;
+
+    /**
+     * Schedule of the event dispatchers in a scene that hold deferred events.
+     *
+     * A dispatcher schedules itself the first time that an event is queued for deferred delivery after its previous
+     * delivery. The scene delivers the deferred events held by all of the scheduled dispatchers once per frame (see
+     * `Scene::process`). The schedule is double-buffered: dispatchers that queue further events whilst deferred events
+     * are being delivered are scheduled for the following delivery.
+     */
+    class EventQueue : private NonCopyable
+    {
+    public:
+        /**
+         * Constructor.
+         */
+        EventQueue();
+
+        /**
+         * Destructor.
+         */
+        ~EventQueue();
+
+        /**
+         * Schedules the specified `dispatcher` for the next delivery.
+         *
+         * @param dispatcher Pointer to the dispatcher holding deferred events.
+         */
+        void schedule(EventDispatcher* dispatcher);
+
+        /**
+         * Delivers the deferred events held by all of the scheduled dispatchers. Dispatchers that have since been
+         * deleted are skipped.
+         */
+        void deliver();
+
+        /**
+         * Checks whether no dispatchers are scheduled.
+         *
+         * @return True if no dispatchers hold deferred events, false otherwise.
+         */
+        bool empty() const;
+
+    private:
+        /**
+         * Dispatchers scheduled for the next delivery.
+         */
+        std::vector<WatchPtr<EventDispatcher>> m_scheduled;
+
+        /**
+         * Dispatchers whose events are being delivered.
+         */
+        std::vector<WatchPtr<EventDispatcher>> m_delivering;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,208 @@
+#ifndef SUBORBITAL_EVENT_STATISTICS_HPP
+#define SUBORBITAL_EVENT_STATISTICS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <suborbital/NonCopyable.hpp>
+
+#include <suborbital/event/EventSubscription.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class Entity;
+    class Scene;
+
+    /**
+     * Time spent executing the callbacks for an event type.
+     */
+    struct CallbackStatistics
+    {
+        /**
+         * Number of callbacks that were executed.
+         */
+        std::size_t calls;
+
+        /**
+         * Total time (in seconds) spent executing the callbacks.
+         */
+        double total_time;
+
+        /**
+         * Longest time (in seconds) spent executing a single callback.
+         */
+        double maximum_time;
+    };
+
+    /**
+     * Statistics recorded for an event type.
+     */
+    struct EventTypeStatistics
+    {
+        /**
+         * Number of events published to dispatchers, including those published to each entity by a broadcast.
+         */
+        std::size_t publishes;
+
+        /**
+         * Largest number of callbacks executed immediately by a single publish.
+         */
+        std::size_t maximum_fan_out;
+
+        /**
+         * Number of events broadcast by scenes and entities.
+         */
+        std::size_t broadcasts;
+
+        /**
+         * Largest number of callbacks executed immediately by a single broadcast.
+         */
+        std::size_t maximum_broadcast_fan_out;
+
+        /**
+         * Callbacks implemented in C++.
+         */
+        CallbackStatistics cpp;
+
+        /**
+         * Callbacks implemented in Python.
+         */
+        CallbackStatistics python;
+    };
+
+    /**
+     * Instrumentation for event dispatch.
+     *
+     * Statistics are only recorded if the library is compiled with `SUBORBITAL_EVENT_STATISTICS` defined (see the
+     * CMake option of the same name). Otherwise the instrumentation is compiled out of `EventDispatcher` and the
+     * broadcast functions, and all statistics read as zero.
+     *
+     * Callback times include the time spent in any events that the callbacks themselves publish. Statistics are
+     * accumulated until `reset` is called, which would typically be done once per frame. Statistics are not
+     * synchronised and should only be accessed from the thread that processes the scenes.
+     */
+    class EventStatistics : private NonCopyable
+    {
+    friend EventDispatcher;
+    friend Entity;
+    friend Scene;
+    public:
+        /**
+         * Default constructor removed.
+         *
+         * Statistics are accessed through the static member functions.
+         */
+        EventStatistics() = delete;
+
+        /**
+         * Whether statistics are recorded.
+         *
+         * @return True if the library was compiled with `SUBORBITAL_EVENT_STATISTICS` defined.
+         */
+        static bool enabled();
+
+        /**
+         * Accessor for the statistics recorded for the specified `event_name`.
+         *
+         * @param event_name Name of the event.
+         * @return Statistics for the event type, which are all zero if nothing has been recorded.
+         */
+        static EventTypeStatistics statistics(const std::string& event_name);
+
+        /**
+         * Accessor for the names of the event types that have had statistics recorded since the last reset.
+         *
+         * @return List of event names.
+         */
+        static std::vector<std::string> event_names();
+
+        /**
+         * Discards all recorded statistics.
+         */
+        static void reset();
+
+    private:
+        /**
+         * Records a broadcast for the lifetime of the object.
+         *
+         * The number of callbacks executed whilst the object exists is recorded as the broadcast's fan-out. Objects
+         * created for the same event type whilst another object exists are treated as part of the same broadcast,
+         * since entities broadcast recursively to their children.
+         */
+        class Broadcast : private NonCopyable
+        {
+        friend EventStatistics;
+        public:
+            /**
+             * Constructor.
+             *
+             * @param event_type Identifier for the event type.
+             */
+            explicit Broadcast(EventTypeId event_type);
+
+            /**
+             * Destructor.
+             */
+            ~Broadcast();
+
+        private:
+            /**
+             * Identifier for the event type.
+             */
+            EventTypeId m_event_type;
+
+            /**
+             * Number of callbacks executed for the event type before the broadcast, or `npos` if the broadcast is part
+             * of another.
+             */
+            std::size_t m_calls;
+
+            /**
+             * The broadcast that was in progress when this one began, or a nullptr.
+             */
+            Broadcast* m_previous;
+        };
+
+    private:
+        /**
+         * Records that an event was published to a dispatcher.
+         *
+         * @param event_type Identifier for the event type.
+         * @param fan_out Number of callbacks that were executed immediately.
+         */
+        static void record_publish(EventTypeId event_type, std::size_t fan_out);
+
+        /**
+         * Records the execution of a callback.
+         *
+         * @param event_type Identifier for the event type.
+         * @param scripted Whether the callback is implemented in Python.
+         * @param seconds Time taken to execute the callback.
+         */
+        static void record_callback(EventTypeId event_type, bool scripted, double seconds);
+
+        /**
+         * Accessor for the recorded statistics for the specified event type, adding an entry if necessary.
+         *
+         * @param event_type Identifier for the event type.
+         * @return Reference to the statistics.
+         */
+        static EventTypeStatistics& entry(EventTypeId event_type);
+
+        /**
+         * Accessor for the broadcast that is in progress.
+         *
+         * @return Reference to the pointer to the innermost broadcast, which is a nullptr if there is none.
+         */
+        static Broadcast*& current_broadcast();
+
+        /**
+         * Value of `Broadcast::m_calls` for broadcasts that are part of another broadcast.
+         */
+        static const std::size_t npos;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,283 @@
+#ifndef SUBORBITAL_EVENT_SUBSCRIBER_HPP
+#define SUBORBITAL_EVENT_SUBSCRIBER_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <suborbital/NonCopyable.hpp>
+
+namespace suborbital
+{
+    // Forward declarations.
+    class Event;
+    class EventSubscription;
+
+    /**
+     * Callback for an event subscription, as stored by the `EventDispatcher`.
+     *
+     * Subscribers are kept by value in contiguous arrays. The callback function object is stored inline, within the
+     * subscriber, provided that it is small enough and can be moved without throwing. Larger function objects are
+     * allocated on the heap. Function objects that can also be called with a
+     * `const std::vector<std::shared_ptr<Event>>&` handle batches of events.
+     *
+     * A subscriber whose subscription has been cancelled is left in place as a tombstone, so that subscriptions may be
+     * cancelled whilst the dispatcher is iterating over its subscribers. Tombstones are removed by the dispatcher, which
+     * destroys their function objects as soon as they can no longer be executing.
+     */
+    class EventSubscriber : private NonCopyable
+    {
+    public:
+        /**
+         * Constructs an empty subscriber, which holds no function object.
+         */
+        EventSubscriber() noexcept;
+
+        /**
+         * Constructor.
+         *
+         * @param callable Function object that is called with a `const std::shared_ptr<Event>&`.
+         */
+        template<typename Callable>
+        explicit EventSubscriber(Callable callable)
+        : m_operations(&operations<Callable>())
+        , m_subscription(nullptr)
+        {
+            if (stored_inline<Callable>())
+            {
+                new (&m_storage) Callable(std::move(callable));
+            }
+            else
+            {
+                new (&m_storage) Callable*(new Callable(std::move(callable)));
+            }
+        }
+
+        /**
+         * Move constructor.
+         *
+         * @param other The subscriber to move from.
+         */
+        EventSubscriber(EventSubscriber&& other) noexcept;
+
+        /**
+         * Move assignment operator.
+         *
+         * @param other The subscriber to move from.
+         */
+        EventSubscriber& operator=(EventSubscriber&& other) noexcept;
+
+        /**
+         * Destructor.
+         */
+        ~EventSubscriber();
+
+        /**
+         * Calls the callback function.
+         *
+         * @param event Shared pointer to the event.
+         */
+        void operator()(const std::shared_ptr<Event>& event)
+        {
+            m_operations->invoke(&m_storage, event);
+        }
+
+        /**
+         * Calls the callback function for a batch of events.
+         *
+         * @param events Shared pointers to the events.
+         */
+        void operator()(const std::vector<std::shared_ptr<Event>>& events)
+        {
+            assert(batched());
+            m_operations->invoke_batch(&m_storage, events);
+        }
+
+        /**
+         * Checks whether the subscriber holds a function object.
+         *
+         * @return True if the subscriber is empty, false otherwise.
+         */
+        bool empty() const;
+
+        /**
+         * Checks whether the callback function handles batches of events.
+         *
+         * @return True if the subscriber may be called with a batch of events, false otherwise.
+         */
+        bool batched() const;
+
+        /**
+         * Accessor for the subscription.
+         *
+         * @return Pointer to the subscription, or a nullptr if the subscription has been cancelled.
+         */
+        EventSubscription* subscription() const;
+
+        /**
+         * Associates the subscriber with the specified `subscription`.
+         *
+         * @param subscription Pointer to the subscription, or a nullptr to mark the subscriber as cancelled.
+         */
+        void subscription(EventSubscription* subscription);
+
+    private:
+        /**
+         * Type-specific operations on the stored function object.
+         */
+        struct Operations
+        {
+            /**
+             * Calls the function object held in `storage`.
+             */
+            void (*invoke)(void* storage, const std::shared_ptr<Event>& event);
+
+            /**
+             * Calls the function object held in `storage` with a batch of events, or a nullptr if the function object
+             * does not handle batches.
+             */
+            void (*invoke_batch)(void* storage, const std::vector<std::shared_ptr<Event>>& events);
+
+            /**
+             * Moves the function object held in `from` into the uninitialised `to`, destructing the original.
+             */
+            void (*move)(void* from, void* to);
+
+            /**
+             * Destructs the function object held in `storage`.
+             */
+            void (*destroy)(void* storage);
+        };
+
+        /**
+         * Size (in bytes) of the inline storage.
+         */
+        static const std::size_t capacity = 48;
+
+        /**
+         * Inline storage for the function object, or for a pointer to the function object.
+         */
+        typedef std::aligned_storage<capacity, alignof(std::max_align_t)>::type Storage;
+
+        /**
+         * Checks whether function objects of the templated type are stored inline.
+         *
+         * @return True if the function object is stored inline, false if it is allocated on the heap.
+         */
+        template<typename Callable>
+        static constexpr bool stored_inline()
+        {
+            return sizeof(Callable) <= capacity && alignof(Callable) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible<Callable>::value;
+        }
+
+        /**
+         * Accessor for the function object of the templated type held in `storage`.
+         *
+         * @param storage Pointer to the storage.
+         * @return Pointer to the function object.
+         */
+        template<typename Callable>
+        static Callable* target(void* storage)
+        {
+            return stored_inline<Callable>() ? static_cast<Callable*>(storage) : *static_cast<Callable**>(storage);
+        }
+
+        /**
+         * Returns the function that calls function objects of the templated type with a batch of events.
+         *
+         * This overload is selected for function objects that can be called with a batch of events.
+         *
+         * @return Pointer to the function.
+         */
+        template<typename Callable>
+        static auto batch_invoker(int)
+            -> decltype(std::declval<Callable&>()(std::declval<const std::vector<std::shared_ptr<Event>>&>()),
+                    static_cast<void (*)(void*, const std::vector<std::shared_ptr<Event>>&)>(nullptr))
+        {
+            return [](void* storage, const std::vector<std::shared_ptr<Event>>& events)
+            {
+                (*target<Callable>(storage))(events);
+            };
+        }
+
+        /**
+         * Returns the function that calls function objects of the templated type with a batch of events.
+         *
+         * This overload is selected for function objects that cannot be called with a batch of events.
+         *
+         * @return A nullptr.
+         */
+        template<typename Callable>
+        static void (*batch_invoker(long))(void*, const std::vector<std::shared_ptr<Event>>&)
+        {
+            return nullptr;
+        }
+
+        /**
+         * Accessor for the operations on function objects of the templated type.
+         *
+         * @return Reference to the operations.
+         */
+        template<typename Callable>
+        static const Operations& operations()
+        {
+            static const Operations result =
+            {
+                [](void* storage, const std::shared_ptr<Event>& event)
+                {
+                    (*target<Callable>(storage))(event);
+                },
+                batch_invoker<Callable>(0),
+                [](void* from, void* to)
+                {
+                    if (stored_inline<Callable>())
+                    {
+                        Callable* callable = static_cast<Callable*>(from);
+                        new (to) Callable(std::move(*callable));
+                        callable->~Callable();
+                    }
+                    else
+                    {
+                        new (to) Callable*(*static_cast<Callable**>(from));
+                    }
+                },
+                [](void* storage)
+                {
+                    if (stored_inline<Callable>())
+                    {
+                        static_cast<Callable*>(storage)->~Callable();
+                    }
+                    else
+                    {
+                        delete *static_cast<Callable**>(storage);
+                    }
+                }
+            };
+
+            return result;
+        }
+
+    private:
+        /**
+         * Storage for the function object.
+         */
+        Storage m_storage;
+
+        /**
+         * Operations on the stored function object, or a nullptr if the subscriber is empty or has been moved from.
+         */
+        const Operations* m_operations;
+
+        /**
+         * The subscription that the subscriber belongs to, or a nullptr if the subscription has been cancelled.
+         */
+        EventSubscription* m_subscription;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,7 +1,7 @@
 #ifndef SUBORBITAL_EVENT_SUBSCRIPTION_HPP
 #define SUBORBITAL_EVENT_SUBSCRIPTION_HPP
 
-#include <string>
+#include <cstddef>
 
 #include <suborbital/NonCopyable.hpp>
 #include <suborbital/WatchPtr.hpp>
@@ -11,6 +11,40 @@ namespace suborbital
     // Forward declarations.
     class EventDispatcher;
 
+    /**
+     * Dense integer identifier for an event type.
+     *
+     * Event names are assigned identifiers, starting from zero, the first time that they are used. Typed events use
+     * the name provided by the `TYPE` macro, so that they share identifiers with events of the same name published or
+     * subscribed for by name (for example from Python).
+     */
+    typedef std::size_t EventTypeId;
+
+    /**
+     * When events are delivered to a subscriber.
+     */
+    enum class EventDelivery
+    {
+        /**
+         * Events are delivered as soon as they are published.
+         */
+        Immediate,
+
+        /**
+         * Events are queued and delivered once per frame, after the entities in the scene have been updated. All of
+         * the queued events of one type are delivered to each subscriber in turn, in the order that they were
+         * published. Events published whilst deferred events are being delivered are delivered in the following frame.
+         */
+        Deferred,
+
+        /**
+         * Events are queued as for `Deferred` delivery, but callbacks that handle batches (such as Python callbacks)
+         * receive all of the queued events of one type in a single call. Other callbacks receive the events one at a
+         * time.
+         */
+        Batched
+    };
+
     /**
      * Manages the lifetime of an event subscription.
      *
@@ -48,13 +82,20 @@ namespace suborbital
          */
         void unsubscribe();
 
+        /**
+         * Whether the subscriber's callback function is implemented in a scripting language.
+         *
+         * @return True if the callback function is implemented in Python.
+         */
+        bool scripted() const;
+
     private:
         /**
          * Constructor.
          *
          * This constructor is available exclusively to the `EventDispatcher` class.
          */
-        EventSubscription(EventDispatcher* dispatcher, const std::string& event_name);
+        EventSubscription(EventDispatcher* dispatcher, EventTypeId event_type, EventDelivery delivery);
 
     private:
         /**
@@ -63,9 +104,24 @@ namespace suborbital
         EventDispatcher* m_dispatcher;
 
         /**
-         * The name of the event that the subscription is for.
+         * Identifier for the event type that the subscription is for.
+         */
+        EventTypeId m_event_type;
+
+        /**
+         * When events are delivered to the subscriber.
+         */
+        EventDelivery m_delivery;
+
+        /**
+         * Position of the subscription's subscriber in the dispatcher's list of subscribers for the event type.
+         */
+        std::size_t m_index;
+
+        /**
+         * Whether the subscriber's callback function is implemented in a scripting language.
          */
-        std::string m_event_name;
+        bool m_scripted;
     };
 }
 
@@ -3,12 +3,80 @@
 
 #include <Python/Python.h>
 
+#include <suborbital/NonCopyable.hpp>
+
 #include <suborbital/event/EventCallbackBase.hpp>
 
 namespace suborbital
 {
     class PythonEventCallback : public EventCallbackBase
     {
+    public:
+        /**
+         * Shares one Python object for an event among all of the Python callbacks that receive the event whilst the
+         * scope exists.
+         *
+         * Scopes are created by `EventDispatcher::publish` and by the broadcast functions of scenes and entities. The
+         * Python object for a C++ defined event is only created once a Python callback receives the event, and is
+         * released when the scope ends. Scopes created for an event whilst a scope already exists for the same event
+         * share the outer scope's object.
+         */
+        class PublishScope : private NonCopyable
+        {
+        friend PythonEventCallback;
+        public:
+            /**
+             * Constructor.
+             *
+             * @param event Shared pointer to the event being published, which must outlive the scope.
+             */
+            explicit PublishScope(const std::shared_ptr<Event>& event);
+
+            /**
+             * Destructor.
+             *
+             * Releases the scope's reference to the Python object, if one was created.
+             */
+            ~PublishScope();
+
+        private:
+            /**
+             * Finds the scope that shares a Python object for the specified `event`.
+             *
+             * @param event Pointer to the event.
+             * @return Pointer to the innermost active scope for the event, or a nullptr if there is none.
+             */
+            static PublishScope* find(const Event* event);
+
+            /**
+             * Accessor for the innermost active scope.
+             *
+             * @return Reference to the pointer to the innermost active scope, which is a nullptr if there is none.
+             */
+            static PublishScope*& current();
+
+        private:
+            /**
+             * Shared pointer to the event being published.
+             */
+            const std::shared_ptr<Event>& m_event;
+
+            /**
+             * Python object for the event, or a nullptr if no Python callback has received the event yet.
+             */
+            PyObject* m_object;
+
+            /**
+             * The active scope that was innermost when this scope was created.
+             */
+            PublishScope* m_previous;
+
+            /**
+             * Whether the scope shares its own Python object, rather than that of an outer scope for the same event.
+             */
+            bool m_active;
+        };
+
     public:
         /**
          * Constructor.
@@ -39,7 +107,34 @@ namespace suborbital
         /**
          * Executes the Python callback function.
          */
-        void operator()(std::shared_ptr<Event> event);
+        void operator()(const std::shared_ptr<Event>& event);
+
+        /**
+         * Executes the Python callback function once, passing a Python list of all of the `events`.
+         *
+         * @param events Shared pointers to the events, in the order that they were published.
+         */
+        void handle_batch(const std::vector<std::shared_ptr<Event>>& events);
+
+        /**
+         * Whether the wrapped callback function is implemented in a scripting language.
+         *
+         * @return True, since the callback function is implemented in Python.
+         */
+        bool scripted() const;
+
+    private:
+        /**
+         * Creates a Python object for the supplied `event`.
+         *
+         * Python defined events are represented by their derived Python instance. C++ defined events are wrapped in
+         * a SWIG proxy object that shares ownership of the event. The proxy is shared with the other Python callbacks
+         * that receive the event whilst a `PublishScope` exists for it.
+         *
+         * @param event Shared pointer to the event.
+         * @return New reference to the Python object.
+         */
+        static PyObject* python_object(const std::shared_ptr<Event>& event);
 
     private:
         /**
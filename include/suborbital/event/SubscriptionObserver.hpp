@@ -0,0 +1,45 @@
+#ifndef SUBORBITAL_SUBSCRIPTION_OBSERVER_HPP
+#define SUBORBITAL_SUBSCRIPTION_OBSERVER_HPP
+
+#include <suborbital/event/EventSubscription.hpp>
+
+namespace suborbital
+{
+    /**
+     * The base class for objects that are notified when an `EventDispatcher` gains its first subscriber, or loses its
+     * last subscriber, for a type of event.
+     *
+     * Subscribers for immediate and deferred delivery are counted together.
+     */
+    class SubscriptionObserver
+    {
+    public:
+        /**
+         * Destructor.
+         */
+        virtual ~SubscriptionObserver();
+
+        /**
+         * Called when the first active subscription for the specified event type is created.
+         *
+         * @param event_type Identifier for the event type.
+         */
+        virtual void first_subscribed(EventTypeId event_type) = 0;
+
+        /**
+         * Called when the last active subscription for the specified event type is cancelled, or when the dispatcher
+         * is destroyed whilst it has active subscriptions for the event type.
+         *
+         * @param event_type Identifier for the event type.
+         */
+        virtual void last_unsubscribed(EventTypeId event_type) = 0;
+
+    protected:
+        /**
+         * Constructor.
+         */
+        SubscriptionObserver();
+    };
+}
+
+#endif
\ No newline at end of file
@@ -15,6 +15,8 @@
 #include <suborbital/EntityManager.hpp>
 
 #include <suborbital/event/EventDispatcher.hpp>
+#include <suborbital/event/EventQueue.hpp>
+#include <suborbital/event/ConcurrentEventQueue.hpp>
 
 #include <suborbital/system/System.hpp>
 #include <suborbital/system/SystemRegistry.hpp>
@@ -29,6 +31,7 @@ namespace suborbital
     class Scene : public Watchable, private NonCopyable
     {
     friend SceneStack;
+    friend EntityManager;
     public:
         /**
          * Destructor.
@@ -90,7 +93,7 @@ namespace suborbital
          * @param event_name Name of the event to publish.
          * @param Shared pointer to the event to be published.
          */
-        void publish(const std::string& event_name, std::shared_ptr<suborbital::Event> event);
+        void publish(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event);
 
         /**
          * Broadcasts an event to the scene and every entity in the scene.
@@ -102,7 +105,7 @@ namespace suborbital
          * @param event_name Name of the event to broadcast.
          * @param Shared pointer to the event to be broadcast.
          */
-        void broadcast(const std::string& event_name, std::shared_ptr<suborbital::Event> event);
+        void broadcast(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event);
 
         /**
          * Subscribes to receive events of the specified `event_name`.
@@ -113,10 +116,111 @@ namespace suborbital
          *
          * @param event_name Name of the event to subscribe for.
          * @param callback Callback function that should receive the events.
+         * @param delivery When events should be delivered to the callback.
          * @return Subscription object that controls the lifetime of the subscription.
          */
         std::unique_ptr<suborbital::EventSubscription> subscribe(const std::string& event_name,
-                std::unique_ptr<suborbital::EventCallbackBase> callback);
+                std::unique_ptr<suborbital::EventCallbackBase> callback,
+                EventDelivery delivery = EventDelivery::Immediate);
+
+        /**
+         * Publishes an event to be dispatched to all subscribers of the event's type on this scene.
+         *
+         * The event type must have been declared using the `TYPE` macro. The event is delivered to subscribers without
+         * looking up the event name.
+         *
+         * @param Shared pointer to the event to be published.
+         */
+        template<typename EventType>
+        void publish(const std::shared_ptr<EventType>& event)
+        {
+            m_event_dispatcher->publish(event);
+        }
+
+        /**
+         * Broadcasts an event to the scene and every entity in the scene.
+         *
+         * @param Shared pointer to the event to be broadcast.
+         */
+        template<typename EventType>
+        void broadcast(const std::shared_ptr<EventType>& event)
+        {
+            broadcast_event(EventDispatcher::event_type<EventType>(), event);
+        }
+
+        /**
+         * Subscribes to receive events of the templated type.
+         *
+         * The event type must have been declared using the `TYPE` macro.
+         *
+         * @param callback_function Function that should receive the events.
+         * @param delivery When events should be delivered to the callback.
+         * @return Subscription object that controls the lifetime of the subscription.
+         */
+        template<typename EventType>
+        std::unique_ptr<suborbital::EventSubscription> subscribe(
+                const std::function<void(std::shared_ptr<EventType>)>& callback_function,
+                EventDelivery delivery = EventDelivery::Immediate)
+        {
+            return m_event_dispatcher->subscribe<EventType>(callback_function, delivery);
+        }
+
+        /**
+         * Posts an event to be published to the subscribers of the specified `event_name` on this scene at the start
+         * of the next call to `process`.
+         *
+         * This function may be called from any thread. Events posted from other threads should be created using
+         * `std::make_shared` rather than `make_event`, since the event pools are not thread-safe.
+         *
+         * @param event_name Name of the event to post.
+         * @param event Shared pointer to the event to be posted.
+         */
+        void post(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event);
+
+        /**
+         * Posts an event to be published to the subscribers of the specified `event_name` on the entity referred to
+         * by the supplied `handle` at the start of the next call to `process`. The event is discarded if the entity
+         * has since been destroyed.
+         *
+         * This function may be called from any thread (see `post`).
+         *
+         * @param handle Handle to the entity.
+         * @param event_name Name of the event to post.
+         * @param event Shared pointer to the event to be posted.
+         */
+        void post(EntityHandle handle, const std::string& event_name, const std::shared_ptr<suborbital::Event>& event);
+
+        /**
+         * Posts an event to be published to the subscribers of the event's type on this scene at the start of the next
+         * call to `process`.
+         *
+         * This function may be called from any thread (see `post`). The event type must have been declared using the
+         * `TYPE` macro.
+         *
+         * @param event Shared pointer to the event to be posted.
+         */
+        template<typename EventType>
+        void post(const std::shared_ptr<EventType>& event)
+        {
+            post(EntityHandle(), &EventDispatcher::event_type<EventType>, event);
+        }
+
+        /**
+         * Posts an event to be published to the subscribers of the event's type on the entity referred to by the
+         * supplied `handle` at the start of the next call to `process`. The event is discarded if the entity has since
+         * been destroyed.
+         *
+         * This function may be called from any thread (see `post`). The event type must have been declared using the
+         * `TYPE` macro.
+         *
+         * @param handle Handle to the entity.
+         * @param event Shared pointer to the event to be posted.
+         */
+        template<typename EventType>
+        void post(EntityHandle handle, const std::shared_ptr<EventType>& event)
+        {
+            post(handle, &EventDispatcher::event_type<EventType>, event);
+        }
 
         /**
          * Creates a new system to process entities in the scene.
@@ -212,16 +316,51 @@ namespace suborbital
          *
          * The scene is processed in the following order:
          *
-         * 1. The scene's `update` function is called.
-         * 2. The scene's systems are processed.
-         * 3. All the entities in the scene are recursively updated.
-         * 4. Entities marked for destruction are deleted.
+         * 1. Events posted since the previous call are published.
+         * 2. The scene's `update` function is called.
+         * 3. The scene's systems are processed.
+         * 4. All the entities in the scene are recursively updated.
+         * 5. Deferred events are delivered.
+         * 6. The structural changes recorded in command buffers are applied.
+         * 7. Entities marked for destruction are deleted.
          *
          * @param dt Time elapsed (in seconds) since the previous call to process.
          */
         void process(double dt);
 
+        /**
+         * Posts an event of a type that is looked up by the supplied function.
+         *
+         * @param handle Handle to the entity, or a null handle to post the event to the scene.
+         * @param event_type Function that looks up the event type identifier.
+         * @param event Shared pointer to the event to be posted.
+         */
+        void post(EntityHandle handle, EventTypeId (*event_type)(), const std::shared_ptr<suborbital::Event>& event);
+
+        /**
+         * Publishes the events that have been posted since the previous call.
+         */
+        void publish_posted();
+
+        /**
+         * Publishes an event to the scene and every entity in the scene.
+         *
+         * Only the entities that have subscribers for the event type are visited (see `EntityManager::subscribers`),
+         * so broadcasting an event that no entity has subscribed for takes constant time.
+         *
+         * @param event_type Identifier for the event type.
+         * @param event Shared pointer to the event to be broadcast.
+         */
+        void broadcast_event(EventTypeId event_type, const std::shared_ptr<suborbital::Event>& event);
+
     private:
+        /**
+         * Queue that delivers the deferred events published to the scene and its entities.
+         *
+         * The queue is declared before the entity manager and event dispatcher so that it outlives them.
+         */
+        EventQueue m_event_queue;
+
         /**
          * Entities that form the contents of the scene.
          */
@@ -237,6 +376,16 @@ namespace suborbital
          */
         std::unique_ptr<EventDispatcher> m_event_dispatcher;
 
+        /**
+         * Events posted from any thread, awaiting publication.
+         */
+        ConcurrentEventQueue m_posted;
+
+        /**
+         * Events being published. Retained between frames to avoid reallocating its storage.
+         */
+        std::vector<ConcurrentEventQueue::Post> m_publishing;
+
         /**
          * The systems that process the entities in the scene.
          *
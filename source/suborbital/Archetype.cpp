@@ -0,0 +1,194 @@
+#include <cassert>
+#include <algorithm>
+#include <functional>
+
+#include <suborbital/Archetype.hpp>
+#include <suborbital/Entity.hpp>
+
+namespace suborbital
+{
+    const std::size_t Archetype::npos = static_cast<std::size_t>(-1);
+
+    Archetype::Archetype(const Signature& signature, const std::vector<std::size_t>& behaviour_columns)
+    : m_signature(signature)
+    , m_behaviour_columns(behaviour_columns)
+    , m_column_lookup(signature.empty() ? 0 : signature.back() + 1, npos)
+    , m_entities()
+    , m_columns(signature.size())
+    , m_vacated()
+    , m_snapshot_size(0)
+    , m_next()
+    {
+        assert(std::is_sorted(m_signature.begin(), m_signature.end()));
+
+        // Iterate backwards so that the first column for each type is recorded.
+        for (std::size_t column = m_signature.size(); column-- > 0;)
+        {
+            m_column_lookup[m_signature[column]] = column;
+        }
+    }
+
+    Archetype::~Archetype()
+    {
+        // Nothing to do.
+    }
+
+    const Archetype::Signature& Archetype::signature() const
+    {
+        return m_signature;
+    }
+
+    std::size_t Archetype::size() const
+    {
+        return m_entities.size();
+    }
+
+    bool Archetype::includes(const Signature& types) const
+    {
+        return std::includes(m_signature.begin(), m_signature.end(), types.begin(), types.end());
+    }
+
+    std::size_t Archetype::column(ComponentTypeId type) const
+    {
+        if (type < m_column_lookup.size())
+        {
+            return m_column_lookup[type];
+        }
+
+        return npos;
+    }
+
+    Entity* Archetype::entity(std::size_t row) const
+    {
+        assert(row < m_entities.size());
+        return m_entities[row];
+    }
+
+    void Archetype::entity(std::size_t row, Entity* entity)
+    {
+        assert(row < m_entities.size());
+        m_entities[row] = entity;
+    }
+
+    Component* Archetype::component(std::size_t column, std::size_t row) const
+    {
+        assert(column < m_columns.size());
+        assert(row < m_entities.size());
+        return m_columns[column][row];
+    }
+
+    void Archetype::component(std::size_t column, std::size_t row, Component* component)
+    {
+        assert(column < m_columns.size());
+        assert(row < m_entities.size());
+        m_columns[column][row] = component;
+    }
+
+    Archetype* Archetype::next(ComponentTypeId type) const
+    {
+        auto position = m_next.find(type);
+        if (position != m_next.end())
+        {
+            return position->second;
+        }
+
+        return nullptr;
+    }
+
+    void Archetype::next(ComponentTypeId type, Archetype* archetype)
+    {
+        m_next[type] = archetype;
+    }
+
+    std::size_t Archetype::insert(Entity* entity)
+    {
+        const std::size_t row = m_entities.size();
+        m_entities.push_back(entity);
+        for (auto& column : m_columns)
+        {
+            column.push_back(nullptr);
+        }
+
+        entity->m_archetype = this;
+        entity->m_row = row;
+        return row;
+    }
+
+    void Archetype::remove(std::size_t row)
+    {
+        assert(row < m_entities.size());
+
+        const std::size_t last = m_entities.size() - 1;
+        if (row != last)
+        {
+            m_entities[row] = m_entities[last];
+            for (auto& column : m_columns)
+            {
+                column[row] = column[last];
+            }
+
+            // Vacated rows may hold a nullptr for the entity.
+            if (m_entities[row] != nullptr)
+            {
+                m_entities[row]->m_row = row;
+            }
+        }
+
+        m_entities.pop_back();
+        for (auto& column : m_columns)
+        {
+            column.pop_back();
+        }
+    }
+
+    void Archetype::vacate(std::size_t row)
+    {
+        assert(row < m_entities.size());
+        m_vacated.push_back(row);
+    }
+
+    void Archetype::compact()
+    {
+        // Remove the vacated rows from last to first, which ensures that the row moved into the place of each removed
+        // row has not itself been vacated.
+        std::sort(m_vacated.begin(), m_vacated.end(), std::greater<std::size_t>());
+        for (std::size_t row : m_vacated)
+        {
+            remove(row);
+        }
+
+        m_vacated.clear();
+    }
+
+    void Archetype::snapshot()
+    {
+        m_snapshot_size = m_entities.size();
+    }
+
+    std::size_t Archetype::snapshot_size() const
+    {
+        return m_snapshot_size;
+    }
+
+    void Archetype::update(double dt, std::size_t rows)
+    {
+        assert(rows <= m_entities.size());
+
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            Entity* entity = m_entities[row];
+            if (entity != nullptr && entity->alive())
+            {
+                for (std::size_t column : m_behaviour_columns)
+                {
+                    // Behaviours removed from the entity during the update leave a nullptr in the vacated row.
+                    Behaviour* behaviour = static_cast<Behaviour*>(m_columns[column][row]);
+                    if (behaviour != nullptr)
+                    {
+                        behaviour->update(dt);
+                    }
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
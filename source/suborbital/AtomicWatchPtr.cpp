@@ -0,0 +1,77 @@
+#include <suborbital/AtomicWatchPtr.hpp>
+#include <suborbital/Watchable.hpp>
+
+namespace suborbital
+{
+    WatchToken::WatchToken(const Watchable* object)
+    : m_object(object)
+    , m_references(1)
+    {
+        // Nothing to do.
+    }
+
+    void WatchToken::acquire()
+    {
+        m_references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void WatchToken::release()
+    {
+        if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+    AtomicWatchPtrBase::AtomicWatchPtrBase()
+    : m_token(nullptr)
+    {
+        // Nothing to do.
+    }
+
+    void AtomicWatchPtrBase::watch(const Watchable* watchable_object)
+    {
+        WatchToken* token = watchable_object != nullptr ? watchable_object->token() : nullptr;
+        if (token != nullptr)
+        {
+            token->acquire();
+        }
+
+        unwatch();
+        m_token = token;
+    }
+
+    void AtomicWatchPtrBase::share(const AtomicWatchPtrBase& other)
+    {
+        // Acquire before releasing, in case both watchers refer to the same token.
+        WatchToken* token = other.m_token;
+        if (token != nullptr)
+        {
+            token->acquire();
+        }
+
+        unwatch();
+        m_token = token;
+    }
+
+    void AtomicWatchPtrBase::transfer(AtomicWatchPtrBase& other) noexcept
+    {
+        unwatch();
+        m_token = other.m_token;
+        other.m_token = nullptr;
+    }
+
+    void AtomicWatchPtrBase::unwatch()
+    {
+        if (m_token != nullptr)
+        {
+            m_token->release();
+            m_token = nullptr;
+        }
+    }
+
+    const Watchable* AtomicWatchPtrBase::watched() const
+    {
+        return m_token != nullptr ? m_token->m_object.load(std::memory_order_acquire) : nullptr;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include <algorithm>
+
+#include <suborbital/Bitset.hpp>
+
+namespace suborbital
+{
+    namespace
+    {
+        /**
+         * Number of bits in each word.
+         */
+        const std::size_t word_bits = 64;
+
+        /**
+         * Counts the set bits in the supplied `word`.
+         */
+        std::size_t popcount(std::uint64_t word)
+        {
+            std::size_t count = 0;
+            while (word != 0)
+            {
+                word &= word - 1;
+                ++count;
+            }
+
+            return count;
+        }
+
+        /**
+         * Returns the index of the lowest set bit in the supplied `word`, which must not be zero.
+         */
+        std::size_t lowest(std::uint64_t word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+            std::size_t bit = 0;
+            while ((word & 1) == 0)
+            {
+                word >>= 1;
+                ++bit;
+            }
+
+            return bit;
+#endif
+        }
+    }
+
+    const std::size_t Bitset::npos = static_cast<std::size_t>(-1);
+
+    Bitset::Bitset()
+    : m_words()
+    {
+        // Nothing to do.
+    }
+
+    Bitset::~Bitset()
+    {
+        // Nothing to do.
+    }
+
+    bool Bitset::test(std::size_t bit) const
+    {
+        const std::size_t word = bit / word_bits;
+        return word < m_words.size() && (m_words[word] & (std::uint64_t(1) << (bit % word_bits))) != 0;
+    }
+
+    void Bitset::set(std::size_t bit)
+    {
+        const std::size_t word = bit / word_bits;
+        if (word >= m_words.size())
+        {
+            m_words.resize(word + 1, 0);
+        }
+
+        m_words[word] |= std::uint64_t(1) << (bit % word_bits);
+    }
+
+    void Bitset::reset(std::size_t bit)
+    {
+        const std::size_t word = bit / word_bits;
+        if (word < m_words.size())
+        {
+            m_words[word] &= ~(std::uint64_t(1) << (bit % word_bits));
+        }
+    }
+
+    void Bitset::clear()
+    {
+        std::fill(m_words.begin(), m_words.end(), 0);
+    }
+
+    bool Bitset::none() const
+    {
+        for (std::uint64_t word : m_words)
+        {
+            if (word != 0)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::size_t Bitset::count() const
+    {
+        std::size_t count = 0;
+        for (std::uint64_t word : m_words)
+        {
+            count += popcount(word);
+        }
+
+        return count;
+    }
+
+    bool Bitset::includes(const Bitset& other) const
+    {
+        for (std::size_t i = 0; i < other.m_words.size(); ++i)
+        {
+            const std::uint64_t word = i < m_words.size() ? m_words[i] : 0;
+            if ((other.m_words[i] & ~word) != 0)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool Bitset::intersects(const Bitset& other) const
+    {
+        const std::size_t words = std::min(m_words.size(), other.m_words.size());
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            if ((m_words[i] & other.m_words[i]) != 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::size_t Bitset::first() const
+    {
+        return search(0);
+    }
+
+    std::size_t Bitset::next(std::size_t bit) const
+    {
+        return search(bit + 1);
+    }
+
+    Bitset& Bitset::operator&=(const Bitset& other)
+    {
+        for (std::size_t i = 0; i < m_words.size(); ++i)
+        {
+            m_words[i] &= i < other.m_words.size() ? other.m_words[i] : 0;
+        }
+
+        return *this;
+    }
+
+    Bitset& Bitset::operator|=(const Bitset& other)
+    {
+        if (other.m_words.size() > m_words.size())
+        {
+            m_words.resize(other.m_words.size(), 0);
+        }
+
+        for (std::size_t i = 0; i < other.m_words.size(); ++i)
+        {
+            m_words[i] |= other.m_words[i];
+        }
+
+        return *this;
+    }
+
+    bool Bitset::operator==(const Bitset& other) const
+    {
+        return includes(other) && other.includes(*this);
+    }
+
+    bool Bitset::operator!=(const Bitset& other) const
+    {
+        return !(*this == other);
+    }
+
+    std::size_t Bitset::search(std::size_t bit) const
+    {
+        std::size_t word = bit / word_bits;
+        if (word >= m_words.size())
+        {
+            return npos;
+        }
+
+        // Mask off the bits below the starting bit in the first word.
+        std::uint64_t bits = m_words[word] & (~std::uint64_t(0) << (bit % word_bits));
+        while (bits == 0)
+        {
+            if (++word == m_words.size())
+            {
+                return npos;
+            }
+
+            bits = m_words[word];
+        }
+
+        return word * word_bits + lowest(bits);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <suborbital/CommandBuffer.hpp>
+
+namespace suborbital
+{
+    const std::size_t CommandBuffer::npos = static_cast<std::size_t>(-1);
+
+    CommandBuffer::Target::Target(EntityHandle handle)
+    : m_handle(handle)
+    , m_created(npos)
+    {
+        // Nothing to do.
+    }
+
+    CommandBuffer::Target::Target(const WatchPtr<Entity>& entity)
+    : m_handle(entity ? entity->handle() : EntityHandle())
+    , m_created(npos)
+    {
+        // Nothing to do.
+    }
+
+    CommandBuffer::Target::Target(std::size_t created)
+    : m_handle()
+    , m_created(created)
+    {
+        // Nothing to do.
+    }
+
+    CommandBuffer::CommandBuffer()
+    : m_commands()
+    , m_created(0)
+    {
+        // Nothing to do.
+    }
+
+    CommandBuffer::~CommandBuffer()
+    {
+        // Nothing to do.
+    }
+
+    CommandBuffer::Target CommandBuffer::create()
+    {
+        return create(std::string());
+    }
+
+    CommandBuffer::Target CommandBuffer::create(const std::string& entity_name)
+    {
+        Target target(m_created++);
+        record(Operation::Create, target, entity_name);
+        return target;
+    }
+
+    void CommandBuffer::destroy(Target target)
+    {
+        record(Operation::Destroy, target, std::string());
+    }
+
+    void CommandBuffer::create_attribute(Target target, const std::string& class_name)
+    {
+        record(Operation::CreateAttribute, target, class_name);
+    }
+
+    void CommandBuffer::create_behaviour(Target target, const std::string& class_name)
+    {
+        record(Operation::CreateBehaviour, target, class_name);
+    }
+
+    void CommandBuffer::remove_component(Target target, const std::string& class_name)
+    {
+        record(Operation::RemoveComponent, target, class_name);
+    }
+
+    void CommandBuffer::add_to_group(Target target, const std::string& group_name)
+    {
+        record(Operation::AddToGroup, target, group_name);
+    }
+
+    void CommandBuffer::remove_from_group(Target target, const std::string& group_name)
+    {
+        record(Operation::RemoveFromGroup, target, group_name);
+    }
+
+    std::size_t CommandBuffer::size() const
+    {
+        return m_commands.size();
+    }
+
+    bool CommandBuffer::empty() const
+    {
+        return m_commands.empty();
+    }
+
+    void CommandBuffer::clear()
+    {
+        m_commands.clear();
+        m_created = 0;
+    }
+
+    void CommandBuffer::record(Operation operation, Target target, const std::string& name, void (*creator)(Entity&))
+    {
+        Command command = { operation, target, name, creator };
+        m_commands.push_back(command);
+    }
+}
\ No newline at end of file
@@ -1,9 +1,12 @@
 #include <suborbital/Entity.hpp>
+#include <suborbital/Archetype.hpp>
 
 #include <suborbital/scene/Scene.hpp>
 
 #include <suborbital/event/EventCallbackBase.hpp>
+#include <suborbital/event/EventStatistics.hpp>
 #include <suborbital/event/EventSubscription.hpp>
+#include <suborbital/event/PythonEventCallback.hpp>
 
 namespace suborbital
 {
@@ -14,11 +17,15 @@ namespace suborbital
     , m_dead(false)
     , m_parent(nullptr)
     , m_children()
-    , m_event_dispatcher(new EventDispatcher())
-    , m_attributes()
-    , m_behaviours()
+    , m_event_dispatcher(nullptr)
+    , m_handle()
+    , m_archetype(nullptr)
+    , m_row(0)
+    , m_groups()
+    , m_name_id(EntityManager::no_name)
+    , m_name_slot(0)
     {
-        // Nothing to do.
+        m_scene.entities().attach(this);
     }
 
     Entity::Entity(Scene& scene, const std::string& name)
@@ -28,16 +35,31 @@ namespace suborbital
     , m_dead(false)
     , m_parent(nullptr)
     , m_children()
-    , m_event_dispatcher(new EventDispatcher())
-    , m_attributes()
-    , m_behaviours()
+    , m_event_dispatcher(nullptr)
+    , m_handle()
+    , m_archetype(nullptr)
+    , m_row(0)
+    , m_groups()
+    , m_name_id(EntityManager::no_name)
+    , m_name_slot(0)
     {
-        // Nothing to do.
+        m_scene.entities().attach(this);
     }
 
     Entity::~Entity()
     {
-        // Nothing to do.
+        EntityManager& manager = m_scene.entities();
+        manager.detach(this);
+
+        for (Entity* child : m_children)
+        {
+            manager.delete_entity(child);
+        }
+
+        if (m_event_dispatcher != nullptr)
+        {
+            manager.delete_dispatcher(m_event_dispatcher);
+        }
     }
 
     Scene& Entity::scene() const
@@ -50,6 +72,11 @@ namespace suborbital
         return m_name;
     }
 
+    EntityHandle Entity::handle() const
+    {
+        return m_handle;
+    }
+
     bool Entity::dead() const
     {
         return m_dead;
@@ -65,6 +92,19 @@ namespace suborbital
         assert(m_dead == false);
         m_dead = true;
         m_scene.entities().destroy(WatchPtr<Entity>(this));
+
+        // Descendants are deleted along with the entity, so they must not be updated either.
+        std::vector<Entity*> descendants;
+        descendants.insert(descendants.end(), m_children.begin(), m_children.end());
+
+        while (!descendants.empty())
+        {
+            Entity* descendant = descendants.back();
+            descendants.pop_back();
+
+            descendant->m_dead = true;
+            descendants.insert(descendants.end(), descendant->m_children.begin(), descendant->m_children.end());
+        }
     }
 
     void Entity::add_to_group(const std::string& group_name)
@@ -77,6 +117,12 @@ namespace suborbital
         m_scene.entities().remove_from_group(group_name, WatchPtr<Entity>(this));
     }
 
+    bool Entity::in_group(const std::string& group_name) const
+    {
+        const EntityManager::GroupId group = m_scene.entities().find_group(group_name);
+        return group != EntityManager::no_group && m_groups.test(group);
+    }
+
     bool Entity::has_children() const
     {
         return m_children.empty() == false;
@@ -94,38 +140,32 @@ namespace suborbital
 
     WatchPtr<Entity> Entity::create_child()
     {
-        Entity* child = new Entity(m_scene);
+        Entity* child = m_scene.entities().create_entity();
         child->m_parent = WatchPtr<Entity>(this);
-        m_children.push_back(std::unique_ptr<Entity>(child));
+        m_children.push_back(child);
         return WatchPtr<Entity>(child);
     }
 
     WatchPtr<Entity> Entity::create_child(const std::string& name)
     {
-        Entity* child = new Entity(m_scene, name);
+        Entity* child = m_scene.entities().create_entity(name);
         child->m_parent = WatchPtr<Entity>(this);
-        m_children.push_back(std::unique_ptr<Entity>(child));
+        m_children.push_back(child);
         return WatchPtr<Entity>(child);
     }
 
     bool Entity::has_attribute(const std::string& class_name) const
     {
-        auto iter = m_attributes.find(class_name);
-        if (iter != m_attributes.end())
-        {
-            return !iter->second.empty();
-        }
-
-        return false;
+        return find_component(class_name, false) != nullptr;
     }
 
     WatchPtr<Attribute> Entity::create_attribute(const std::string& class_name)
     {
-        std::unique_ptr<Attribute> attribute = component_registry().create_attribute(class_name);
+        std::unique_ptr<Attribute, ComponentDeleter> attribute = component_registry().create_attribute(class_name);
         assert(attribute != nullptr);
 
-        Attribute* attribute_ptr = attribute.get();
-        m_attributes[class_name].push_back(std::move(attribute));
+        Attribute* attribute_ptr = attribute.release();
+        attach_component(component_registry().type_id(class_name), attribute_ptr, false);
         attribute_ptr->m_entity = this;
         attribute_ptr->create();
 
@@ -134,63 +174,145 @@ namespace suborbital
 
     WatchPtr<Attribute> Entity::attribute(const std::string& class_name) const
     {
-        auto iter = m_attributes.find(class_name);
-        assert(iter != m_attributes.end());
-        assert(iter->second.empty() == false);
+        Component* component = find_component(class_name, false);
+        assert(component != nullptr);
 
-        Attribute* attribute = iter->second.front().get();
+        Attribute* attribute = static_cast<Attribute*>(component);
         WatchPtr<Attribute> watch_attribute(attribute);
         return watch_attribute;
     }
 
     void Entity::create_behaviour(const std::string& class_name)
     {
-        std::unique_ptr<Behaviour> behaviour = component_registry().create_behaviour(class_name);
+        std::unique_ptr<Behaviour, ComponentDeleter> behaviour = component_registry().create_behaviour(class_name);
         assert(behaviour != nullptr);
 
-        Behaviour* behaviour_ptr = behaviour.get();
-        m_behaviours[class_name].push_back(std::move(behaviour));
+        Behaviour* behaviour_ptr = behaviour.release();
+        attach_component(component_registry().type_id(class_name), behaviour_ptr, true);
         behaviour_ptr->m_entity = this;
         behaviour_ptr->create();
     }
 
-    void Entity::publish(const std::string& event_name, std::shared_ptr<Event> event)
+    void Entity::publish(const std::string& event_name, const std::shared_ptr<Event>& event)
     {
-        m_event_dispatcher->publish(event_name, event);
+        // Entities without a dispatcher have never had any subscribers.
+        if (m_event_dispatcher != nullptr)
+        {
+            m_event_dispatcher->publish(event_name, event);
+        }
     }
 
-    void Entity::broadcast_descendents(const std::string& event_name, std::shared_ptr<suborbital::Event> event)
+    void Entity::broadcast_descendents(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event)
     {
-        for (auto& child : m_children)
+        // The event name is looked up once for all of the descendants.
+        const EventTypeId event_type = EventDispatcher::find_event_type(event_name);
+        if (event_type != EventDispatcher::no_event_type)
         {
-            child->broadcast(event_name, event);
+            broadcast_event(event_type, event, false);
         }
     }
 
-    void Entity::broadcast(const std::string& event_name, std::shared_ptr<suborbital::Event> event)
+    void Entity::broadcast(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event)
     {
-        publish(event_name, event);
-
-        for (auto& child : m_children)
+        const EventTypeId event_type = EventDispatcher::find_event_type(event_name);
+        if (event_type != EventDispatcher::no_event_type)
         {
-            child->broadcast(event_name, event);
+            broadcast_event(event_type, event, true);
         }
     }
 
-    std::unique_ptr<EventSubscription> Entity::subscribe(const std::string& event_name,
-            std::unique_ptr<EventCallbackBase> callback)
+    void Entity::broadcast_event(EventTypeId event_type, const std::shared_ptr<suborbital::Event>& event,
+            bool include_self)
     {
-        return m_event_dispatcher->subscribe(event_name, std::move(callback));
+#ifdef SUBORBITAL_EVENT_STATISTICS
+        EventStatistics::Broadcast statistics(event_type);
+#endif
+
+        // Only the entities that have subscribers for the event type are visited, rather than the whole hierarchy
+        // below this entity. Entities that subscribe during the broadcast do not receive the event.
+        const EntityView entities = m_scene.entities().subscribers(event_type);
+        if (entities.empty())
+        {
+            return;
+        }
+
+        // Python callbacks on all of the entities share a single Python object for the event.
+        PythonEventCallback::PublishScope scope(event);
+
+        for (auto iter = entities.cbegin(), end = entities.cend(); iter != end; ++iter)
+        {
+            const WatchPtr<Entity>& entity = *iter;
+            if (entity->alive() && ((include_self && entity.get() == this) || entity->descends_from(this)))
+            {
+                entity->m_event_dispatcher->publish(event_type, event);
+            }
+        }
     }
 
-    void Entity::update(double dt)
+    bool Entity::descends_from(const Entity* ancestor) const
     {
-        for (auto iter = m_behaviours.begin(); iter != m_behaviours.end(); ++iter)
+        for (const Entity* entity = m_parent.get(); entity != nullptr; entity = entity->m_parent.get())
         {
-            for (auto& c : iter->second)
+            if (entity == ancestor)
             {
-                c->update(dt);
+                return true;
             }
         }
+
+        return false;
+    }
+
+    std::unique_ptr<EventSubscription> Entity::subscribe(const std::string& event_name,
+            std::unique_ptr<EventCallbackBase> callback, EventDelivery delivery)
+    {
+        return event_dispatcher().subscribe(event_name, std::move(callback), delivery);
+    }
+
+    EventDispatcher& Entity::event_dispatcher()
+    {
+        if (m_event_dispatcher == nullptr)
+        {
+            m_event_dispatcher = m_scene.entities().create_dispatcher(this);
+        }
+
+        return *m_event_dispatcher;
+    }
+
+    void Entity::first_subscribed(EventTypeId event_type)
+    {
+        m_scene.entities().index_subscriber(this, event_type);
+    }
+
+    void Entity::last_unsubscribed(EventTypeId event_type)
+    {
+        m_scene.entities().unindex_subscriber(this, event_type);
+    }
+
+    void Entity::attach_component(ComponentTypeId type, Component* component, bool behaviour)
+    {
+        m_scene.entities().attach_component(this, type, component, behaviour);
+    }
+
+    Component* Entity::find_component(ComponentTypeId type) const
+    {
+        const std::size_t column = m_archetype->column(type);
+        if (column != Archetype::npos)
+        {
+            return m_archetype->component(column, m_row);
+        }
+
+        return nullptr;
+    }
+
+    Component* Entity::find_component(const std::string& class_name, bool behaviour) const
+    {
+        // No entity can have a component whose class name has never been used.
+        const ComponentTypeId type = component_registry().find_type_id(class_name);
+        if (type == ComponentRegistry::npos || m_scene.entities().is_behaviour(type) != behaviour)
+        {
+            return nullptr;
+        }
+
+        return find_component(type);
     }
 }
\ No newline at end of file
@@ -1,89 +1,306 @@
 #include <cassert>
+#include <algorithm>
 
 #include <suborbital/Entity.hpp>
 #include <suborbital/EntityManager.hpp>
 
+#include <suborbital/event/EventDispatcher.hpp>
+
 #include <suborbital/scene/Scene.hpp>
 
 namespace suborbital
 {
+    const EntityManager::GroupId EntityManager::no_group = static_cast<GroupId>(-1);
+    const EntityNameId EntityManager::no_name = static_cast<EntityNameId>(-1);
+
     EntityManager::EntityManager(Scene& scene)
     : m_scene(scene)
+    , m_dispatcher_pool()
+    , m_entity_pool()
     , m_entities()
-    , m_entities_by_group()
-    , m_groups_by_entity()
+    , m_group_ids()
+    , m_groups()
+    , m_name_ids()
+    , m_entities_by_name()
+    , m_subscribers()
     , m_destroyed()
+    , m_slots()
+    , m_free_slots()
+    , m_behaviour_types()
+    , m_archetypes()
+    , m_archetypes_by_signature()
+    , m_commands()
+    , m_submitted()
+    , m_submitted_created(0)
+    , m_submitted_mutex()
+    , m_queries()
+    , m_locks(0)
+    , m_vacated(false)
     {
-        // Nothing to do.
+        // Entities without any components are stored in the archetype with the empty signature.
+        archetype(Archetype::Signature());
     }
 
     EntityManager::~EntityManager()
     {
+        purge();
+
         for (auto iter = m_entities.begin(); iter != m_entities.end(); ++iter)
         {
             const WatchPtr<Entity>& entity = *iter;
             assert(static_cast<bool>(entity) == true);
 
-            delete entity.get();
+            delete_entity(entity.get());
+        }
+    }
+
+    EntityView EntityManager::all() const
+    {
+        return EntityView(m_entities, *this, no_group);
+    }
+
+    EntityView EntityManager::group(const std::string& group_name) const
+    {
+        const GroupId group = find_group(group_name);
+        if (group != no_group)
+        {
+            return EntityView(*m_groups[group], *this, group);
         }
+
+        return EntityView();
     }
 
-    const EntitySet EntityManager::all() const
+    EntitySet EntityManager::intersect_groups(const std::vector<std::string>& group_names) const
     {
-        return m_entities;
+        EntitySet result;
+        if (group_names.empty())
+        {
+            return result;
+        }
+
+        // Build the mask of groups to test for, whilst finding the smallest group to scan.
+        Bitset mask;
+        const EntitySet* smallest = nullptr;
+        for (const std::string& group_name : group_names)
+        {
+            const GroupId group = find_group(group_name);
+            if (group == no_group)
+            {
+                return result;
+            }
+
+            mask.set(group);
+            if (smallest == nullptr || m_groups[group]->size() < smallest->size())
+            {
+                smallest = m_groups[group].get();
+            }
+        }
+
+        for (auto iter = smallest->cbegin(); iter != smallest->cend(); ++iter)
+        {
+            const WatchPtr<Entity>& entity = *iter;
+            if (entity->m_groups.includes(mask))
+            {
+                result.insert(entity);
+            }
+        }
+
+        return result;
     }
 
-    const EntitySet EntityManager::group(const std::string& group_name) const
+    EntityNameId EntityManager::name_id(const std::string& entity_name)
     {
-        auto position = m_entities_by_group.find(group_name);
-        if (position != m_entities_by_group.end())
+        auto result = m_name_ids.insert(std::make_pair(entity_name, m_entities_by_name.size()));
+        if (result.second)
         {
-            return position->second;
+            m_entities_by_name.emplace_back();
         }
 
-        return EntitySet();
+        return result.first->second;
+    }
+
+    WatchPtr<Entity> EntityManager::find_by_name(const std::string& entity_name) const
+    {
+        return find_by_name(find_name(entity_name));
+    }
+
+    WatchPtr<Entity> EntityManager::find_by_name(EntityNameId name) const
+    {
+        return WatchPtr<Entity>(find_named(name, no_group));
+    }
+
+    bool EntityManager::valid(EntityHandle handle) const
+    {
+        return get(handle) != nullptr;
+    }
+
+    Entity* EntityManager::get(EntityHandle handle) const
+    {
+        if (handle.index() < m_slots.size())
+        {
+            const Slot& slot = m_slots[handle.index()];
+            if (slot.generation == handle.generation())
+            {
+                return slot.entity;
+            }
+        }
+
+        return nullptr;
     }
 
     void EntityManager::add_to_group(const std::string& group_name, WatchPtr<Entity> entity)
     {
-        EntitySet& group = m_entities_by_group[group_name];
-        assert(group.find(entity) == group.end());
+        const GroupId group = intern_group(group_name);
+        assert(entity->m_groups.test(group) == false);
 
-        group.insert(entity);
-        m_groups_by_entity[entity.get()].insert(group_name);
+        m_groups[group]->insert(entity);
+        entity->m_groups.set(group);
     }
 
     void EntityManager::remove_from_group(const std::string& group_name, WatchPtr<Entity> entity)
     {
-        EntitySet& group = m_entities_by_group[group_name];
-        bool success = group.remove(entity);
+        const GroupId group = find_group(group_name);
+        assert(group != no_group && entity->m_groups.test(group) == true);
 
+        bool success = m_groups[group]->remove(entity);
         assert(success == true);
+
+        entity->m_groups.reset(group);
     }
 
     void EntityManager::remove_from_all_groups(WatchPtr<Entity> entity)
     {
         // Remove the entity from any groups that it is a member of.
-        for (const std::string& group_name : m_groups_by_entity[entity.get()])
+        Bitset& groups = entity->m_groups;
+        for (std::size_t group = groups.first(); group != Bitset::npos; group = groups.next(group))
         {
-            remove_from_group(group_name, entity);
+            bool success = m_groups[group]->remove(entity);
+            assert(success == true);
         }
 
-        // Remove the set of group names that the entity is a member of.
-        std::size_t removals = m_groups_by_entity.erase(entity.get());
-        assert(removals == 1);
+        groups.clear();
+    }
+
+    EntityManager::GroupId EntityManager::find_group(const std::string& group_name) const
+    {
+        auto position = m_group_ids.find(group_name);
+        return position != m_group_ids.end() ? position->second : no_group;
+    }
+
+    EntityNameId EntityManager::find_name(const std::string& entity_name) const
+    {
+        auto position = m_name_ids.find(entity_name);
+        return position != m_name_ids.end() ? position->second : no_name;
+    }
+
+    Entity* EntityManager::find_named(EntityNameId name, GroupId group) const
+    {
+        if (name == no_name)
+        {
+            return nullptr;
+        }
+
+        const EntitySet& entities = group == no_group ? m_entities : *m_groups[group];
+        const std::vector<Entity*>& named = m_entities_by_name[name];
+        if (named.size() <= entities.size())
+        {
+            for (Entity* entity : named)
+            {
+                const bool member = group == no_group ? !entity->has_parent() : entity->m_groups.test(group);
+                if (member && entity->alive())
+                {
+                    return entity;
+                }
+            }
+        }
+        else
+        {
+            // Comparing name identifiers avoids comparing strings.
+            for (auto iter = entities.cbegin(); iter != entities.cend(); ++iter)
+            {
+                if ((*iter)->m_name_id == name && (*iter)->alive())
+                {
+                    return iter->get();
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    void EntityManager::index_name(Entity* entity)
+    {
+        if (!entity->m_name.empty())
+        {
+            const EntityNameId name = name_id(entity->m_name);
+            std::vector<Entity*>& named = m_entities_by_name[name];
+            entity->m_name_id = name;
+            entity->m_name_slot = named.size();
+            named.push_back(entity);
+        }
+    }
+
+    void EntityManager::unindex_name(Entity* entity)
+    {
+        if (entity->m_name_id != no_name)
+        {
+            // Move the last entity with the same name into the vacated position.
+            std::vector<Entity*>& named = m_entities_by_name[entity->m_name_id];
+            assert(named[entity->m_name_slot] == entity);
+
+            named[entity->m_name_slot] = named.back();
+            named[entity->m_name_slot]->m_name_slot = entity->m_name_slot;
+            named.pop_back();
+
+            entity->m_name_id = no_name;
+        }
+    }
+
+    EntityManager::GroupId EntityManager::intern_group(const std::string& group_name)
+    {
+        auto result = m_group_ids.insert(std::make_pair(group_name, m_groups.size()));
+        if (result.second)
+        {
+            m_groups.emplace_back(new EntitySet());
+        }
+
+        return result.first->second;
+    }
+
+    CommandBuffer& EntityManager::commands()
+    {
+        return m_commands;
+    }
+
+    void EntityManager::submit(CommandBuffer& buffer)
+    {
+        std::lock_guard<std::mutex> guard(m_submitted_mutex);
+
+        // Renumber the entities created by the buffer so that they are distinct from those of other buffers.
+        for (CommandBuffer::Command& command : buffer.m_commands)
+        {
+            if (command.target.m_created != CommandBuffer::npos)
+            {
+                command.target.m_created += m_submitted_created;
+            }
+
+            m_submitted.push_back(std::move(command));
+        }
+
+        m_submitted_created += buffer.m_created;
+        buffer.clear();
     }
 
     WatchPtr<Entity> EntityManager::create()
     {
-        Entity* entity = new Entity(m_scene);
+        Entity* entity = create_entity();
         auto position = m_entities.insert(WatchPtr<Entity>(entity));
         return *position;
     }
 
     WatchPtr<Entity> EntityManager::create(const std::string& entity_name)
     {
-        Entity* entity = new Entity(m_scene, entity_name);
+        Entity* entity = create_entity(entity_name);
         auto position = m_entities.insert(WatchPtr<Entity>(entity));
         return *position;
     }
@@ -104,9 +321,449 @@ namespace suborbital
     {
         for (Entity* entity : m_destroyed)
         {
-            delete entity;
+            // Child entities are owned by their parents, so they must be released by the parent before deletion.
+            // Note that a child can only be destroyed ahead of its parent.
+            Entity* parent = entity->m_parent.get();
+            if (parent != nullptr)
+            {
+                auto& siblings = parent->m_children;
+                auto position = std::find(siblings.begin(), siblings.end(), entity);
+                assert(position != siblings.end());
+                siblings.erase(position);
+            }
+
+            delete_entity(entity);
         }
 
         m_destroyed.clear();
     }
+
+    Entity* EntityManager::create_entity()
+    {
+        return m_entity_pool.create(m_scene);
+    }
+
+    Entity* EntityManager::create_entity(const std::string& entity_name)
+    {
+        Entity* entity = m_entity_pool.create(m_scene, entity_name);
+        index_name(entity);
+        return entity;
+    }
+
+    void EntityManager::delete_entity(Entity* entity)
+    {
+        m_entity_pool.destroy(entity);
+    }
+
+    EventDispatcher* EntityManager::create_dispatcher(SubscriptionObserver* observer)
+    {
+        return m_dispatcher_pool.create(&m_scene.m_event_queue, observer);
+    }
+
+    void EntityManager::delete_dispatcher(EventDispatcher* dispatcher)
+    {
+        m_dispatcher_pool.destroy(dispatcher);
+    }
+
+    void EntityManager::index_subscriber(Entity* entity, EventTypeId event_type)
+    {
+        while (event_type >= m_subscribers.size())
+        {
+            m_subscribers.emplace_back(new EntitySet());
+        }
+
+        m_subscribers[event_type]->insert(WatchPtr<Entity>(entity));
+    }
+
+    void EntityManager::unindex_subscriber(Entity* entity, EventTypeId event_type)
+    {
+        assert(event_type < m_subscribers.size());
+
+        bool success = m_subscribers[event_type]->remove(WatchPtr<Entity>(entity));
+        assert(success == true);
+    }
+
+    EntityView EntityManager::subscribers(EventTypeId event_type) const
+    {
+        if (event_type < m_subscribers.size())
+        {
+            return EntityView(*m_subscribers[event_type]);
+        }
+
+        return EntityView();
+    }
+
+    bool EntityManager::has_subscribers(EventTypeId event_type) const
+    {
+        return event_type < m_subscribers.size() && !m_subscribers[event_type]->empty();
+    }
+
+    void EntityManager::execute()
+    {
+        submit(m_commands);
+
+        std::vector<CommandBuffer::Command> commands;
+        std::size_t created_count;
+        {
+            std::lock_guard<std::mutex> guard(m_submitted_mutex);
+            commands.swap(m_submitted);
+            created_count = m_submitted_created;
+            m_submitted_created = 0;
+        }
+
+        // Existing entities are ordered by slot, followed by the entities to be created in order of creation.
+        auto key = [](const CommandBuffer::Target& target)
+        {
+            return target.m_created == CommandBuffer::npos
+                ? std::make_pair(false, static_cast<std::size_t>(target.m_handle.index()))
+                : std::make_pair(true, target.m_created);
+        };
+
+        std::stable_sort(commands.begin(), commands.end(),
+                [&key](const CommandBuffer::Command& a, const CommandBuffer::Command& b)
+                {
+                    return key(a.target) < key(b.target);
+                });
+
+        std::vector<WatchPtr<Entity>> created(created_count);
+        for (const CommandBuffer::Command& command : commands)
+        {
+            const CommandBuffer::Target& target = command.target;
+            if (command.operation == CommandBuffer::Operation::Create)
+            {
+                created[target.m_created] = create(command.name);
+                continue;
+            }
+
+            // Commands targeting entities that no longer exist, or that have been destroyed, are discarded.
+            Entity* entity = target.m_created != CommandBuffer::npos ? created[target.m_created].get()
+                                                                      : get(target.m_handle);
+            if (entity == nullptr || entity->dead())
+            {
+                continue;
+            }
+
+            switch (command.operation)
+            {
+                case CommandBuffer::Operation::Create:
+                    break;
+
+                case CommandBuffer::Operation::Destroy:
+                    entity->destroy();
+                    break;
+
+                case CommandBuffer::Operation::CreateAttribute:
+                    if (command.creator != nullptr)
+                    {
+                        command.creator(*entity);
+                    }
+                    else
+                    {
+                        entity->create_attribute(command.name);
+                    }
+                    break;
+
+                case CommandBuffer::Operation::CreateBehaviour:
+                    if (command.creator != nullptr)
+                    {
+                        command.creator(*entity);
+                    }
+                    else
+                    {
+                        entity->create_behaviour(command.name);
+                    }
+                    break;
+
+                case CommandBuffer::Operation::RemoveComponent:
+                {
+                    // Components whose class name has never been used cannot be attached.
+                    const ComponentTypeId type = component_registry().find_type_id(command.name);
+                    if (type != ComponentRegistry::npos)
+                    {
+                        detach_component(entity, type);
+                    }
+                    break;
+                }
+
+                case CommandBuffer::Operation::AddToGroup:
+                    if (!entity->in_group(command.name))
+                    {
+                        add_to_group(command.name, WatchPtr<Entity>(entity));
+                    }
+                    break;
+
+                case CommandBuffer::Operation::RemoveFromGroup:
+                    if (entity->in_group(command.name))
+                    {
+                        remove_from_group(command.name, WatchPtr<Entity>(entity));
+                    }
+                    break;
+            }
+        }
+    }
+
+    void EntityManager::update(double dt)
+    {
+        // Archetypes created during the update hold only entities that were created, or that had components attached,
+        // during the update, so these are skipped along with any rows appended after the snapshot.
+        const std::size_t count = m_archetypes.size();
+
+        lock();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Archetype& archetype = *m_archetypes[i];
+            archetype.update(dt, archetype.snapshot_size());
+        }
+        unlock();
+    }
+
+    void EntityManager::attach(Entity* entity)
+    {
+        std::uint32_t index;
+        if (m_free_slots.empty())
+        {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{nullptr, 1});
+        }
+        else
+        {
+            index = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+
+        Slot& slot = m_slots[index];
+        slot.entity = entity;
+        entity->m_handle = EntityHandle(index, slot.generation);
+
+        m_archetypes.front()->insert(entity);
+    }
+
+    void EntityManager::detach(Entity* entity)
+    {
+        unindex_name(entity);
+
+        Archetype* archetype = entity->m_archetype;
+        const std::size_t row = entity->m_row;
+        assert(archetype != nullptr);
+        assert(archetype->entity(row) == entity);
+
+        for (std::size_t column = 0; column < archetype->signature().size(); ++column)
+        {
+            component_registry().destroy_component(archetype->component(column, row));
+            archetype->component(column, row, nullptr);
+        }
+
+        if (m_locks > 0)
+        {
+            archetype->vacate(row);
+            archetype->entity(row, nullptr);
+            m_vacated = true;
+        }
+        else
+        {
+            archetype->remove(row);
+        }
+
+        entity->m_archetype = nullptr;
+
+        // Release the slot, incrementing the generation so that existing handles to the entity become stale. Zero is
+        // skipped as it is reserved for null handles.
+        const std::uint32_t index = entity->m_handle.index();
+        Slot& slot = m_slots[index];
+        assert(slot.entity == entity);
+
+        slot.entity = nullptr;
+        if (++slot.generation == 0)
+        {
+            slot.generation = 1;
+        }
+
+        m_free_slots.push_back(index);
+    }
+
+    void EntityManager::attach_component(Entity* entity, ComponentTypeId type, Component* component, bool behaviour)
+    {
+        if (type >= m_behaviour_types.size())
+        {
+            m_behaviour_types.resize(type + 1, false);
+        }
+
+        m_behaviour_types[type] = behaviour;
+
+        Archetype* source = entity->m_archetype;
+        const std::size_t source_row = entity->m_row;
+        const Archetype::Signature& source_signature = source->signature();
+
+        // Additional components of the same type are placed after those already attached, so that the first
+        // component attached is always found first.
+        const auto position = std::upper_bound(source_signature.begin(), source_signature.end(), type);
+        const std::size_t new_column = static_cast<std::size_t>(position - source_signature.begin());
+
+        // Find the destination archetype, using the cached transition where possible.
+        Archetype* destination = source->next(type);
+        if (destination == nullptr)
+        {
+            Archetype::Signature signature(source_signature);
+            signature.insert(signature.begin() + new_column, type);
+            destination = &archetype(signature);
+            source->next(type, destination);
+        }
+
+        // Move the entity's existing components across, leaving a space for the new component.
+        const std::size_t row = destination->insert(entity);
+        for (std::size_t column = 0; column < source_signature.size(); ++column)
+        {
+            const std::size_t destination_column = column < new_column ? column : column + 1;
+            destination->component(destination_column, row, source->component(column, source_row));
+        }
+
+        destination->component(new_column, row, component);
+
+        if (m_locks > 0)
+        {
+            source->vacate(source_row);
+            m_vacated = true;
+        }
+        else
+        {
+            source->remove(source_row);
+        }
+    }
+
+    EntityQuery& EntityManager::query(const std::vector<std::string>& class_names)
+    {
+        Archetype::Signature types;
+        for (const std::string& class_name : class_names)
+        {
+            // No archetype includes the `npos` type, so queries for unknown class names share a single empty query.
+            const ComponentTypeId type = component_registry().find_type_id(class_name);
+            if (type == ComponentRegistry::npos)
+            {
+                return query(Archetype::Signature(1, ComponentRegistry::npos));
+            }
+
+            types.push_back(type);
+        }
+
+        return query(types);
+    }
+
+    EntityQuery& EntityManager::query(Archetype::Signature types)
+    {
+        std::sort(types.begin(), types.end());
+        types.erase(std::unique(types.begin(), types.end()), types.end());
+
+        std::unique_ptr<EntityQuery>& query = m_queries[types];
+        if (query == nullptr)
+        {
+            query.reset(new EntityQuery(*this, types));
+            for (const auto& archetype : m_archetypes)
+            {
+                query->consider(*archetype);
+            }
+        }
+
+        return *query;
+    }
+
+    void EntityManager::lock()
+    {
+        if (m_locks++ == 0)
+        {
+            for (const auto& archetype : m_archetypes)
+            {
+                archetype->snapshot();
+            }
+        }
+    }
+
+    void EntityManager::unlock()
+    {
+        assert(m_locks > 0);
+        if (--m_locks == 0 && m_vacated)
+        {
+            // Remove any rows that were vacated whilst locked.
+            for (const auto& archetype : m_archetypes)
+            {
+                archetype->compact();
+            }
+
+            m_vacated = false;
+        }
+    }
+
+    void EntityManager::detach_component(Entity* entity, ComponentTypeId type)
+    {
+        Archetype* source = entity->m_archetype;
+        const std::size_t source_row = entity->m_row;
+        const std::size_t removed_column = source->column(type);
+        if (removed_column == Archetype::npos)
+        {
+            return;
+        }
+
+        Archetype::Signature signature(source->signature());
+        signature.erase(signature.begin() + removed_column);
+        Archetype* destination = &archetype(signature);
+
+        // Move the entity's remaining components across.
+        Component* component = source->component(removed_column, source_row);
+        const std::size_t row = destination->insert(entity);
+        for (std::size_t column = 0; column < source->signature().size(); ++column)
+        {
+            if (column != removed_column)
+            {
+                const std::size_t destination_column = column < removed_column ? column : column - 1;
+                destination->component(destination_column, row, source->component(column, source_row));
+            }
+        }
+
+        if (m_locks > 0)
+        {
+            // The vacated row must not refer to the component once it has been destroyed.
+            source->component(removed_column, source_row, nullptr);
+            source->vacate(source_row);
+            m_vacated = true;
+        }
+        else
+        {
+            source->remove(source_row);
+        }
+
+        component_registry().destroy_component(component);
+    }
+
+    bool EntityManager::is_behaviour(ComponentTypeId type) const
+    {
+        return type < m_behaviour_types.size() && m_behaviour_types[type];
+    }
+
+    Archetype& EntityManager::archetype(const Archetype::Signature& signature)
+    {
+        auto position = m_archetypes_by_signature.find(signature);
+        if (position != m_archetypes_by_signature.end())
+        {
+            return *position->second;
+        }
+
+        std::vector<std::size_t> behaviour_columns;
+        for (std::size_t column = 0; column < signature.size(); ++column)
+        {
+            if (m_behaviour_types[signature[column]])
+            {
+                behaviour_columns.push_back(column);
+            }
+        }
+
+        Archetype* archetype = new Archetype(signature, behaviour_columns);
+        m_archetypes.push_back(std::unique_ptr<Archetype>(archetype));
+        m_archetypes_by_signature.insert(std::make_pair(signature, archetype));
+
+        for (const auto& signature_query : m_queries)
+        {
+            signature_query.second->consider(*archetype);
+        }
+
+        return *archetype;
+    }
 }
\ No newline at end of file
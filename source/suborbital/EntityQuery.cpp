@@ -0,0 +1,152 @@
+#include <suborbital/Entity.hpp>
+#include <suborbital/EntityManager.hpp>
+#include <suborbital/EntityQuery.hpp>
+
+namespace suborbital
+{
+    EntityQuery::const_iterator::const_iterator(const EntityQuery* query, std::size_t archetype, std::size_t row)
+    : m_query(query)
+    , m_archetype(archetype)
+    , m_row(row)
+    {
+        m_query->lock();
+        skip();
+    }
+
+    EntityQuery::const_iterator::const_iterator(const const_iterator& other)
+    : m_query(other.m_query)
+    , m_archetype(other.m_archetype)
+    , m_row(other.m_row)
+    {
+        m_query->lock();
+    }
+
+    EntityQuery::const_iterator::~const_iterator()
+    {
+        m_query->unlock();
+    }
+
+    EntityQuery::const_iterator& EntityQuery::const_iterator::operator=(const const_iterator& other)
+    {
+        other.m_query->lock();
+        m_query->unlock();
+
+        m_query = other.m_query;
+        m_archetype = other.m_archetype;
+        m_row = other.m_row;
+        return *this;
+    }
+
+    Entity* EntityQuery::const_iterator::operator*() const
+    {
+        return m_query->m_archetypes[m_archetype]->entity(m_row);
+    }
+
+    EntityQuery::const_iterator& EntityQuery::const_iterator::operator++()
+    {
+        ++m_row;
+        skip();
+        return *this;
+    }
+
+    EntityQuery::const_iterator EntityQuery::const_iterator::operator++(int)
+    {
+        const_iterator previous(*this);
+        ++(*this);
+        return previous;
+    }
+
+    bool EntityQuery::const_iterator::operator==(const const_iterator& other) const
+    {
+        return m_query == other.m_query && m_archetype == other.m_archetype && m_row == other.m_row;
+    }
+
+    bool EntityQuery::const_iterator::operator!=(const const_iterator& other) const
+    {
+        return !(*this == other);
+    }
+
+    void EntityQuery::const_iterator::skip()
+    {
+        const std::vector<Archetype*>& archetypes = m_query->m_archetypes;
+        while (m_archetype < archetypes.size())
+        {
+            const Archetype* archetype = archetypes[m_archetype];
+            while (m_row < archetype->snapshot_size())
+            {
+                // Entities that have since moved to another archetype are visited at the row they occupied when the
+                // snapshot was taken, provided that they still match the query.
+                const Entity* entity = archetype->entity(m_row);
+                if (entity != nullptr && entity->alive() && (entity->m_archetype == archetype
+                        || entity->m_archetype->includes(m_query->m_signature)))
+                {
+                    return;
+                }
+
+                ++m_row;
+            }
+
+            ++m_archetype;
+            m_row = 0;
+        }
+
+        // Iterators that have run off the end are all equal, even if archetypes are added during iteration.
+        m_archetype = Archetype::npos;
+    }
+
+    EntityQuery::EntityQuery(EntityManager& manager, const Archetype::Signature& signature)
+    : m_manager(manager)
+    , m_signature(signature)
+    , m_archetypes()
+    {
+        // Nothing to do.
+    }
+
+    EntityQuery::~EntityQuery()
+    {
+        // Nothing to do.
+    }
+
+    const Archetype::Signature& EntityQuery::signature() const
+    {
+        return m_signature;
+    }
+
+    std::size_t EntityQuery::size() const
+    {
+        return static_cast<std::size_t>(std::distance(begin(), end()));
+    }
+
+    bool EntityQuery::empty() const
+    {
+        return begin() == end();
+    }
+
+    EntityQuery::const_iterator EntityQuery::begin() const
+    {
+        return const_iterator(this, 0, 0);
+    }
+
+    EntityQuery::const_iterator EntityQuery::end() const
+    {
+        return const_iterator(this, Archetype::npos, 0);
+    }
+
+    void EntityQuery::consider(Archetype& archetype)
+    {
+        if (archetype.includes(m_signature))
+        {
+            m_archetypes.push_back(&archetype);
+        }
+    }
+
+    void EntityQuery::lock() const
+    {
+        m_manager.lock();
+    }
+
+    void EntityQuery::unlock() const
+    {
+        m_manager.unlock();
+    }
+}
\ No newline at end of file
@@ -1,10 +1,18 @@
+#include <cassert>
+#include <cstdint>
+
 #include <suborbital/Entity.hpp>
 #include <suborbital/EntitySet.hpp>
 
 namespace suborbital
 {
+    const std::size_t EntitySet::npos = static_cast<std::size_t>(-1);
+
     EntitySet::EntitySet()
-    : m_entities()
+    : m_dense()
+    , m_sparse()
+    , m_size(0)
+    , m_locks(0)
     {
         // Nothing to do.
     }
@@ -15,54 +23,72 @@ namespace suborbital
     }
 
     EntitySet::EntitySet(const EntitySet& other)
-    : m_entities(other.m_entities)
+    : m_dense()
+    , m_sparse()
+    , m_size(0)
+    , m_locks(0)
     {
-        // Nothing to do.
+        *this = other;
     }
 
     EntitySet& EntitySet::operator=(const EntitySet& other)
     {
-        m_entities = other.m_entities;
+        if (this != &other)
+        {
+            clear();
+
+            // Only the entities are copied, leaving the tombstones behind.
+            m_dense.reserve(other.m_size);
+            for (auto iter = other.cbegin(); iter != other.cend(); ++iter)
+            {
+                insert(*iter);
+            }
+        }
+
         return *this;
     }
 
     std::size_t EntitySet::size() const
     {
-        return m_entities.size();
+        return m_size;
     }
 
     bool EntitySet::empty() const
     {
-        return m_entities.empty();
+        return m_size == 0;
     }
 
-    EntitySet::iterator EntitySet::find(WatchPtr<Entity> entity)
+    EntitySet::iterator EntitySet::find(const WatchPtr<Entity>& entity)
     {
-        return m_entities.find(entity);
+        return static_cast<const EntitySet*>(this)->find(entity);
     }
 
-    EntitySet::const_iterator EntitySet::find(WatchPtr<Entity> entity) const
+    EntitySet::const_iterator EntitySet::find(const WatchPtr<Entity>& entity) const
     {
-        return m_entities.find(entity);
-    }
-
-    EntitySet::iterator EntitySet::find_by_name(const std::string& entity_name)
-    {
-        for (auto iter = m_entities.begin(); iter != m_entities.end(); ++iter)
+        if (entity)
         {
-            const WatchPtr<Entity>& entity = *iter;
-            if (entity->name() == entity_name)
+            const std::uint32_t index = entity->handle().index();
+            if (index < m_sparse.size())
             {
-                return iter;
+                const std::size_t position = m_sparse[index];
+                if (position < m_dense.size() && m_dense[position] == entity)
+                {
+                    return const_iterator(this, position);
+                }
             }
         }
 
-        return end();
+        return cend();
+    }
+
+    EntitySet::iterator EntitySet::find_by_name(const std::string& entity_name)
+    {
+        return static_cast<const EntitySet*>(this)->find_by_name(entity_name);
     }
 
     EntitySet::const_iterator EntitySet::find_by_name(const std::string& entity_name) const
     {
-        for (auto iter = m_entities.begin(); iter != m_entities.end(); ++iter)
+        for (auto iter = cbegin(); iter != cend(); ++iter)
         {
             const WatchPtr<Entity>& entity = *iter;
             if (entity->name() == entity_name)
@@ -76,21 +102,56 @@ namespace suborbital
 
     EntitySet::iterator EntitySet::insert(WatchPtr<Entity> entity)
     {
-        std::pair<iterator, bool> insertion = m_entities.insert(entity);
-        return insertion.first;
+        assert(static_cast<bool>(entity) == true);
+
+        auto position = find(entity);
+        if (position != end())
+        {
+            return position;
+        }
+
+        // Compact the dense array once the tombstones outnumber the entities, unless the set is being iterated over.
+        if (m_locks == 0 && m_dense.size() - m_size > m_size)
+        {
+            compact();
+        }
+
+        const std::uint32_t index = entity->handle().index();
+        if (index >= m_sparse.size())
+        {
+            m_sparse.resize(index + 1, npos);
+        }
+
+        m_sparse[index] = m_dense.size();
+        m_dense.push_back(std::move(entity));
+        ++m_size;
+
+        return iterator(this, m_dense.size() - 1);
     }
 
     EntitySet::iterator EntitySet::remove(const_iterator position)
     {
-        return m_entities.erase(position);
+        assert(position.m_set == this);
+        assert(position.m_position < m_dense.size());
+
+        WatchPtr<Entity>& entity = m_dense[position.m_position];
+        if (entity)
+        {
+            m_sparse[entity->handle().index()] = npos;
+        }
+
+        entity = nullptr;
+        --m_size;
+
+        return ++position;
     }
 
-    bool EntitySet::remove(WatchPtr<Entity> entity)
+    bool EntitySet::remove(const WatchPtr<Entity>& entity)
     {
-        auto position = m_entities.find(entity);
-        if (position != m_entities.end())
+        auto position = find(entity);
+        if (position != end())
         {
-            m_entities.erase(position);
+            remove(position);
             return true;
         }
 
@@ -99,26 +160,72 @@ namespace suborbital
 
     void EntitySet::clear()
     {
-        m_entities.clear();
+        if (m_locks > 0)
+        {
+            for (auto iter = begin(); iter != end();)
+            {
+                iter = remove(iter);
+            }
+
+            return;
+        }
+
+        m_dense.clear();
+        m_sparse.clear();
+        m_size = 0;
     }
 
     EntitySet::iterator EntitySet::begin()
     {
-        return m_entities.begin();
+        return iterator(this, 0);
     }
 
     EntitySet::const_iterator EntitySet::cbegin() const
     {
-        return m_entities.cbegin();
+        return const_iterator(this, 0);
     }
 
     EntitySet::iterator EntitySet::end()
     {
-        return m_entities.end();
+        return iterator(this, m_dense.size());
     }
 
     EntitySet::const_iterator EntitySet::cend() const
     {
-        return m_entities.cend();
+        return const_iterator(this, m_dense.size());
+    }
+
+    void EntitySet::compact()
+    {
+        std::size_t count = 0;
+        for (std::size_t position = 0; position < m_dense.size(); ++position)
+        {
+            // Entities that were deleted whilst in the set are discarded along with the tombstones.
+            const WatchPtr<Entity>& entity = m_dense[position];
+            if (entity)
+            {
+                m_sparse[entity->handle().index()] = count;
+                if (position != count)
+                {
+                    m_dense[count] = std::move(m_dense[position]);
+                }
+
+                ++count;
+            }
+        }
+
+        m_dense.resize(count);
+        m_size = count;
+    }
+
+    void EntitySet::lock() const
+    {
+        ++m_locks;
+    }
+
+    void EntitySet::unlock() const
+    {
+        assert(m_locks > 0);
+        --m_locks;
     }
 }
\ No newline at end of file
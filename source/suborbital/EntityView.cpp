@@ -0,0 +1,110 @@
+#include <suborbital/Entity.hpp>
+#include <suborbital/EntityView.hpp>
+#include <suborbital/EntityManager.hpp>
+
+namespace suborbital
+{
+    EntityView::EntityView()
+    : m_set(nullptr)
+    , m_manager(nullptr)
+    , m_group(0)
+    {
+        // Nothing to do.
+    }
+
+    EntityView::EntityView(const EntitySet& set)
+    : m_set(&set)
+    , m_manager(nullptr)
+    , m_group(0)
+    {
+        // Nothing to do.
+    }
+
+    EntityView::EntityView(const EntitySet& set, const EntityManager& manager, std::size_t group)
+    : m_set(&set)
+    , m_manager(&manager)
+    , m_group(group)
+    {
+        // Nothing to do.
+    }
+
+    EntityView::~EntityView()
+    {
+        // Nothing to do.
+    }
+
+    std::size_t EntityView::size() const
+    {
+        return m_set != nullptr ? m_set->size() : 0;
+    }
+
+    bool EntityView::empty() const
+    {
+        return size() == 0;
+    }
+
+    bool EntityView::contains(const WatchPtr<Entity>& entity) const
+    {
+        return m_set != nullptr && m_set->find(entity) != m_set->cend();
+    }
+
+    WatchPtr<Entity> EntityView::find_by_name(const std::string& entity_name) const
+    {
+        if (m_manager != nullptr)
+        {
+            return find_by_name(m_manager->find_name(entity_name));
+        }
+
+        if (m_set != nullptr)
+        {
+            auto position = m_set->find_by_name(entity_name);
+            if (position != m_set->cend())
+            {
+                return *position;
+            }
+        }
+
+        return nullptr;
+    }
+
+    WatchPtr<Entity> EntityView::find_by_name(EntityNameId name) const
+    {
+        if (m_manager != nullptr)
+        {
+            return WatchPtr<Entity>(m_manager->find_named(name, m_group));
+        }
+
+        if (m_set != nullptr)
+        {
+            for (auto iter = m_set->cbegin(); iter != m_set->cend(); ++iter)
+            {
+                if ((*iter)->m_name_id == name)
+                {
+                    return *iter;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    EntityView::const_iterator EntityView::begin() const
+    {
+        return cbegin();
+    }
+
+    EntityView::const_iterator EntityView::cbegin() const
+    {
+        return const_iterator(m_set, m_set != nullptr ? m_set->cbegin() : EntitySet::const_iterator());
+    }
+
+    EntityView::const_iterator EntityView::end() const
+    {
+        return cend();
+    }
+
+    EntityView::const_iterator EntityView::cend() const
+    {
+        return const_iterator(m_set, m_set != nullptr ? m_set->cend() : EntitySet::const_iterator());
+    }
+}
\ No newline at end of file
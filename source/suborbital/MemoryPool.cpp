@@ -0,0 +1,112 @@
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#include <suborbital/MemoryPool.hpp>
+
+namespace suborbital
+{
+    namespace
+    {
+        /**
+         * Rounds `value` up to the nearest multiple of `alignment`, which must be a power of two.
+         */
+        std::size_t align_up(std::size_t value, std::size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    MemoryPool::MemoryPool(std::size_t block_size, std::size_t block_alignment, std::size_t blocks_per_slab)
+    : m_block_size(block_size)
+    , m_block_alignment(block_alignment < alignof(void*) ? alignof(void*) : block_alignment)
+    , m_stride(align_up(block_size < sizeof(void*) ? sizeof(void*) : block_size, m_block_alignment))
+    , m_blocks_per_slab(blocks_per_slab)
+    , m_slabs()
+    , m_free(nullptr)
+    , m_size(0)
+    , m_high_water_mark(0)
+    {
+        assert((m_block_alignment & (m_block_alignment - 1)) == 0);
+        assert(m_blocks_per_slab > 0);
+    }
+
+    MemoryPool::~MemoryPool()
+    {
+        for (void* slab : m_slabs)
+        {
+            ::operator delete(slab);
+        }
+    }
+
+    void* MemoryPool::allocate()
+    {
+        if (m_free == nullptr)
+        {
+            grow();
+        }
+
+        void* block = m_free;
+        m_free = *static_cast<void**>(block);
+
+        if (++m_size > m_high_water_mark)
+        {
+            m_high_water_mark = m_size;
+        }
+
+        return block;
+    }
+
+    void MemoryPool::deallocate(void* block)
+    {
+        assert(block != nullptr);
+        assert(m_size > 0);
+
+        *static_cast<void**>(block) = m_free;
+        m_free = block;
+        --m_size;
+    }
+
+    std::size_t MemoryPool::block_size() const
+    {
+        return m_block_size;
+    }
+
+    std::size_t MemoryPool::block_alignment() const
+    {
+        return m_block_alignment;
+    }
+
+    std::size_t MemoryPool::size() const
+    {
+        return m_size;
+    }
+
+    std::size_t MemoryPool::capacity() const
+    {
+        return m_slabs.size() * m_blocks_per_slab;
+    }
+
+    std::size_t MemoryPool::high_water_mark() const
+    {
+        return m_high_water_mark;
+    }
+
+    void MemoryPool::grow()
+    {
+        // Over-allocate so that the first block can be aligned regardless of the alignment of the slab itself.
+        void* slab = ::operator new(m_stride * m_blocks_per_slab + m_block_alignment - 1);
+        m_slabs.push_back(slab);
+
+        const std::uintptr_t first = align_up(reinterpret_cast<std::uintptr_t>(slab), m_block_alignment);
+        char* blocks = reinterpret_cast<char*>(first);
+
+        // Thread the new blocks onto the free list in reverse order so that they are handed out in address order.
+        for (std::size_t i = m_blocks_per_slab; i-- > 0;)
+        {
+            void* block = blocks + i * m_stride;
+            *static_cast<void**>(block) = m_free;
+            m_free = block;
+        }
+    }
+}
\ No newline at end of file
@@ -7,6 +7,8 @@ namespace suborbital
 {
     WatchPtrBase::WatchPtrBase()
     : ptr(nullptr)
+    , m_previous(nullptr)
+    , m_next(nullptr)
     {
         // Nothing to do.
     }
@@ -19,7 +21,14 @@ namespace suborbital
         // Start watching the provided object.
         if (watchable_object != nullptr)
         {
-            watchable_object->m_watchers.insert(this);
+            // Insert at the head of the object's list of watchers.
+            m_next = watchable_object->m_watchers;
+            if (m_next != nullptr)
+            {
+                m_next->m_previous = this;
+            }
+
+            watchable_object->m_watchers = this;
             ptr = watchable_object;
         }
     }
@@ -28,10 +37,56 @@ namespace suborbital
     {
         if (ptr != nullptr)
         {
-            std::size_t removed = ptr->m_watchers.erase(this);
-            assert(removed == 1);
+            // Splice this watcher out of the object's list of watchers.
+            if (m_previous != nullptr)
+            {
+                m_previous->m_next = m_next;
+            }
+            else
+            {
+                assert(ptr->m_watchers == this);
+                ptr->m_watchers = m_next;
+            }
+
+            if (m_next != nullptr)
+            {
+                m_next->m_previous = m_previous;
+            }
 
             ptr = nullptr;
+            m_previous = nullptr;
+            m_next = nullptr;
+        }
+    }
+
+    void WatchPtrBase::transfer(WatchPtrBase& other) noexcept
+    {
+        unwatch();
+
+        if (other.ptr != nullptr)
+        {
+            // Take over the other watcher's links, and point its neighbours at this watcher instead.
+            ptr = other.ptr;
+            m_previous = other.m_previous;
+            m_next = other.m_next;
+
+            if (m_previous != nullptr)
+            {
+                m_previous->m_next = this;
+            }
+            else
+            {
+                ptr->m_watchers = this;
+            }
+
+            if (m_next != nullptr)
+            {
+                m_next->m_previous = this;
+            }
+
+            other.ptr = nullptr;
+            other.m_previous = nullptr;
+            other.m_next = nullptr;
         }
     }
 }
\ No newline at end of file
@@ -3,21 +3,75 @@
 namespace suborbital
 {
     Watchable::Watchable()
-    : m_watchers()
+    : m_watchers(nullptr)
+    , m_token(nullptr)
+    {
+        // Nothing to do.
+    }
+
+    Watchable::Watchable(const Watchable& other)
+    : m_watchers(nullptr)
+    , m_token(nullptr)
     {
         // Nothing to do.
     }
 
     Watchable::~Watchable()
     {
-        for (WatchPtrBase* watcher : m_watchers)
+        WatchPtrBase* watcher = m_watchers;
+        while (watcher != nullptr)
         {
+            WatchPtrBase* next = watcher->m_next;
+
             watcher->ptr = nullptr;
+            watcher->m_previous = nullptr;
+            watcher->m_next = nullptr;
+
+            watcher = next;
+        }
+
+        // Atomic watchers observe the deletion through the shared token, which lives on until they release it.
+        WatchToken* token = m_token.load(std::memory_order_acquire);
+        if (token != nullptr)
+        {
+            token->m_object.store(nullptr, std::memory_order_release);
+            token->release();
         }
     }
 
+    Watchable& Watchable::operator=(const Watchable& other)
+    {
+        return *this;
+    }
+
+    WatchToken* Watchable::token() const
+    {
+        WatchToken* token = m_token.load(std::memory_order_acquire);
+        if (token == nullptr)
+        {
+            // Only one of any racing threads installs its token; the others discard theirs.
+            WatchToken* created = new WatchToken(this);
+            if (m_token.compare_exchange_strong(token, created, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                token = created;
+            }
+            else
+            {
+                delete created;
+            }
+        }
+
+        return token;
+    }
+
     std::size_t Watchable::use_count() const
     {
-        return m_watchers.size();
+        std::size_t count = 0;
+        for (const WatchPtrBase* watcher = m_watchers; watcher != nullptr; watcher = watcher->m_next)
+        {
+            ++count;
+        }
+
+        return count;
     }
 }
\ No newline at end of file
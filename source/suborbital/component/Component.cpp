@@ -4,6 +4,7 @@ namespace suborbital
 {
     Component::Component()
     : m_entity(nullptr)
+    , m_pool(nullptr)
     {
         // Nothing to do.
     }
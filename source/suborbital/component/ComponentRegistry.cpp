@@ -1,12 +1,25 @@
 #include <suborbital/component/ComponentRegistry.hpp>
+#include <suborbital/component/Component.hpp>
 #include <suborbital/component/AttributeFactory.hpp>
 #include <suborbital/component/PythonBehaviourFactory.hpp>
 #include <suborbital/component/PythonAttributeFactory.hpp>
 
 namespace suborbital
 {
+    void ComponentDeleter::operator()(Component* component) const
+    {
+        if (component != nullptr)
+        {
+            component_registry().destroy_component(component);
+        }
+    }
+
+    const ComponentTypeId ComponentRegistry::npos = static_cast<ComponentTypeId>(-1);
+
     ComponentRegistry::ComponentRegistry()
-    : m_factory_registry()
+    : m_type_registry()
+    , m_factory_registry()
+    , m_pools()
     {
         // Nothing to do.
     }
@@ -18,40 +31,131 @@ namespace suborbital
 
     void ComponentRegistry::register_component(const std::string& name, std::unique_ptr<ComponentFactory> factory)
     {
-        m_factory_registry.insert(FactoryRegistry::value_type(name, std::move(factory)));
+        register_component(type_id(name), std::move(factory));
+    }
+
+    void ComponentRegistry::register_component(ComponentTypeId type, std::unique_ptr<ComponentFactory> factory)
+    {
+        if (type >= m_factory_registry.size())
+        {
+            m_factory_registry.resize(type + 1);
+        }
+
+        // The first factory registered to a type is retained.
+        if (m_factory_registry[type] == nullptr)
+        {
+            m_factory_registry[type] = std::move(factory);
+        }
+    }
+
+    ComponentTypeId ComponentRegistry::type_id(const std::string& name)
+    {
+        auto insertion = m_type_registry.insert(TypeRegistry::value_type(name, m_type_registry.size()));
+        return insertion.first->second;
+    }
+
+    ComponentTypeId ComponentRegistry::find_type_id(const std::string& name) const
+    {
+        auto position = m_type_registry.find(name);
+        return position != m_type_registry.end() ? position->second : npos;
+    }
+
+    std::size_t ComponentRegistry::type_count() const
+    {
+        return m_type_registry.size();
+    }
+
+    ComponentFactory* ComponentRegistry::factory(ComponentTypeId type) const
+    {
+        if (type < m_factory_registry.size())
+        {
+            return m_factory_registry[type].get();
+        }
+
+        return nullptr;
+    }
+
+    void ComponentRegistry::destroy_component(Component* component)
+    {
+        MemoryPool* memory_pool = component->m_pool;
+        if (memory_pool == nullptr)
+        {
+            delete component;
+            return;
+        }
+
+        // The block begins at the most derived object, which need not coincide with the component base.
+        void* block = dynamic_cast<void*>(component);
+        component->~Component();
+        memory_pool->deallocate(block);
+    }
+
+    const MemoryPool* ComponentRegistry::component_pool(ComponentTypeId type) const
+    {
+        if (type < m_pools.size())
+        {
+            return m_pools[type].get();
+        }
+
+        return nullptr;
     }
 
-    std::unique_ptr<Attribute> ComponentRegistry::create_attribute(const std::string& name) const
+    MemoryPool& ComponentRegistry::pool(ComponentTypeId type, std::size_t size, std::size_t alignment)
     {
-        // We will first attempt to instantiate an attribute registered under the supplied name.
-        auto iter = m_factory_registry.find(name);
-        if (iter != m_factory_registry.end())
+        if (type >= m_pools.size())
         {
-            std::unique_ptr<Component> component = iter->second->create();
-            return std::unique_ptr<Attribute>(dynamic_cast<Attribute*>(component.release()));
+            m_pools.resize(type + 1);
         }
 
-        // If no attribute was registered under the supplied name then we attempt to instantiate a scripted attribute.
-        // Note that the factory's create function will return a nullptr in the event that it is unable to instantiate
-        // the attribute.
-        AttributeFactory<PythonAttribute> factory(name);
-        return std::unique_ptr<Attribute>(dynamic_cast<Attribute*>(factory.create().release()));
+        std::unique_ptr<MemoryPool>& memory_pool = m_pools[type];
+        if (memory_pool == nullptr)
+        {
+            memory_pool.reset(new MemoryPool(size, alignment));
+        }
+
+        assert(memory_pool->block_size() == size);
+        return *memory_pool;
     }
 
-    std::unique_ptr<Behaviour> ComponentRegistry::create_behaviour(const std::string& name) const
+    std::unique_ptr<Attribute, ComponentDeleter> ComponentRegistry::create_attribute(const std::string& name) const
     {
-        // We will first attempt to instantiate a behaviour registered under the supplied name.
-        auto iter = m_factory_registry.find(name);
-        if (iter != m_factory_registry.end())
+        // We will first attempt to instantiate an attribute registered under the supplied name. If no attribute was
+        // registered under the supplied name then we attempt to instantiate a scripted attribute. Note that the
+        // factory's create function will return a nullptr in the event that it is unable to instantiate the attribute.
+        auto iter = m_type_registry.find(name);
+        ComponentFactory* registered_factory = iter != m_type_registry.end() ? factory(iter->second) : nullptr;
+        std::unique_ptr<Component, ComponentDeleter> component = registered_factory != nullptr
+                ? registered_factory->create() : AttributeFactory<PythonAttribute>(name).create();
+
+        // The component is cast whilst it is still owned, so that it is destroyed if it is not an attribute.
+        Attribute* attribute = dynamic_cast<Attribute*>(component.get());
+        if (attribute == nullptr)
+        {
+            return nullptr;
+        }
+
+        component.release();
+        return std::unique_ptr<Attribute, ComponentDeleter>(attribute);
+    }
+
+    std::unique_ptr<Behaviour, ComponentDeleter> ComponentRegistry::create_behaviour(const std::string& name) const
+    {
+        // We will first attempt to instantiate a behaviour registered under the supplied name. If no behaviour was
+        // registered under the supplied name then we attempt to instantiate a scripted behaviour. Note that the
+        // factory's create function will return a nullptr in the event that it is unable to instantiate the behaviour.
+        auto iter = m_type_registry.find(name);
+        ComponentFactory* registered_factory = iter != m_type_registry.end() ? factory(iter->second) : nullptr;
+        std::unique_ptr<Component, ComponentDeleter> component = registered_factory != nullptr
+                ? registered_factory->create() : BehaviourFactory<PythonBehaviour>(name).create();
+
+        // The component is cast whilst it is still owned, so that it is destroyed if it is not a behaviour.
+        Behaviour* behaviour = dynamic_cast<Behaviour*>(component.get());
+        if (behaviour == nullptr)
         {
-            std::unique_ptr<Component> component = iter->second->create();
-            return std::unique_ptr<Behaviour>(dynamic_cast<Behaviour*>(component.release()));
+            return nullptr;
         }
 
-        // If no behaviour was registered under the supplied name then we attempt to instantiate a scripted behaviour.
-        // Note that the factory's create function will return a nullptr in the event that it is unable to instantiate
-        // the behaviour.
-        BehaviourFactory<PythonBehaviour> factory(name);
-        return std::unique_ptr<Behaviour>(dynamic_cast<Behaviour*>(factory.create().release()));
+        component.release();
+        return std::unique_ptr<Behaviour, ComponentDeleter>(behaviour);
     }
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <suborbital/event/Event.hpp>
+#include <suborbital/event/ConcurrentEventQueue.hpp>
+
+namespace suborbital
+{
+    ConcurrentEventQueue::ConcurrentEventQueue()
+    : m_head(nullptr)
+    {
+        // Nothing to do.
+    }
+
+    ConcurrentEventQueue::~ConcurrentEventQueue()
+    {
+        Node* node = m_head.load(std::memory_order_acquire);
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    void ConcurrentEventQueue::push(Post post)
+    {
+        Node* node = new Node();
+        node->post = std::move(post);
+        node->next = m_head.load(std::memory_order_relaxed);
+
+        // On failure the current head is written back into `next`, ready for the next attempt.
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+            // Nothing to do.
+        }
+    }
+
+    void ConcurrentEventQueue::drain(std::vector<Post>& posts)
+    {
+        // Detaching the whole list at once leaves nothing for producers to race with.
+        Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+        // The list runs from the most recently pushed node, so it is reversed to restore the order of posting.
+        Node* reversed = nullptr;
+        while (node != nullptr)
+        {
+            Node* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        while (reversed != nullptr)
+        {
+            Node* next = reversed->next;
+            posts.push_back(std::move(reversed->post));
+            delete reversed;
+            reversed = next;
+        }
+    }
+
+    bool ConcurrentEventQueue::empty() const
+    {
+        return m_head.load(std::memory_order_relaxed) == nullptr;
+    }
+}
\ No newline at end of file
@@ -11,4 +11,17 @@ namespace suborbital
     {
         // Nothing to do.
     }
+
+    void EventCallbackBase::handle_batch(const std::vector<std::shared_ptr<Event>>& events)
+    {
+        for (const std::shared_ptr<Event>& event : events)
+        {
+            (*this)(event);
+        }
+    }
+
+    bool EventCallbackBase::scripted() const
+    {
+        return false;
+    }
 }
\ No newline at end of file
@@ -1,61 +1,547 @@
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <unordered_map>
 
 #include <suborbital/event/Event.hpp>
 #include <suborbital/event/EventDispatcher.hpp>
+#include <suborbital/event/EventQueue.hpp>
+#include <suborbital/event/EventStatistics.hpp>
 #include <suborbital/event/EventSubscription.hpp>
 #include <suborbital/event/EventCallbackBase.hpp>
+#include <suborbital/event/PythonEventCallback.hpp>
+#include <suborbital/event/SubscriptionObserver.hpp>
 
 namespace suborbital
 {
-    EventDispatcher::EventDispatcher()
-    : m_subscriptions()
+    namespace
+    {
+        /**
+         * Map from event names to event type identifiers.
+         */
+        std::unordered_map<std::string, EventTypeId>& event_types()
+        {
+            static std::unordered_map<std::string, EventTypeId> types;
+            return types;
+        }
+
+        /**
+         * Coalescing policy for an event type.
+         */
+        struct Coalescing
+        {
+            EventCoalescing policy;
+            EventMerge merge;
+        };
+
+        /**
+         * Coalescing policies, indexed by event type identifier.
+         */
+        std::vector<Coalescing>& coalescing_policies()
+        {
+            static std::vector<Coalescing> policies;
+            return policies;
+        }
+
+        /**
+         * Looks up the coalescing policy for the specified event type.
+         *
+         * @param event_type Identifier for the event type.
+         * @return Reference to the policy, which must not be retained whilst policies are being set.
+         */
+        Coalescing& coalescing_policy(EventTypeId event_type)
+        {
+            std::vector<Coalescing>& policies = coalescing_policies();
+            if (event_type >= policies.size())
+            {
+                Coalescing none = { EventCoalescing::None, EventMerge() };
+                policies.resize(event_type + 1, none);
+            }
+
+            return policies[event_type];
+        }
+
+        /**
+         * Function object that calls a callback through the `EventCallbackBase` interface.
+         */
+        struct CallbackAdapter
+        {
+            void operator()(const std::shared_ptr<Event>& event) const
+            {
+                (*callback)(event);
+            }
+
+            std::unique_ptr<EventCallbackBase> callback;
+        };
+
+        /**
+         * Function object that calls a callback through the `EventCallbackBase` interface, passing batches of events to
+         * `EventCallbackBase::handle_batch`.
+         */
+        struct BatchCallbackAdapter
+        {
+            void operator()(const std::shared_ptr<Event>& event) const
+            {
+                // Single events are only dispatched to batched subscribers by dispatchers without an event queue.
+                callback->handle_batch(std::vector<std::shared_ptr<Event>>(1, event));
+            }
+
+            void operator()(const std::vector<std::shared_ptr<Event>>& events) const
+            {
+                callback->handle_batch(events);
+            }
+
+            std::unique_ptr<EventCallbackBase> callback;
+        };
+    }
+
+    const EventTypeId EventDispatcher::no_event_type = static_cast<EventTypeId>(-1);
+
+    EventDispatcher::EventDispatcher(EventQueue* queue, SubscriptionObserver* observer)
+    : m_queue(queue)
+    , m_observer(observer)
+    , m_subscriptions()
+    , m_deferred_subscriptions()
+    , m_dirty()
+    , m_dispatching(0)
+    , m_queued()
+    , m_delivering()
+    , m_scheduled(false)
     {
         // Nothing to do.
     }
 
     EventDispatcher::~EventDispatcher()
     {
+        if (m_observer != nullptr)
+        {
+            const std::size_t event_types = std::max(m_subscriptions.size(), m_deferred_subscriptions.size());
+            for (EventTypeId event_type = 0; event_type < event_types; ++event_type)
+            {
+                if (has_subscribers(event_type))
+                {
+                    m_observer->last_unsubscribed(event_type);
+                }
+            }
+        }
+
         // Cancel all managed event subscriptions, ensuring that we don't have any dangling pointers to the dispatcher.
-        for (const auto& event_name_subscriptions : m_subscriptions)
+        for (std::vector<SubscriberList>* lists : { &m_subscriptions, &m_deferred_subscriptions })
+        {
+            for (SubscriberList& list : *lists)
+            {
+                for (std::vector<EventSubscriber>* subscribers : { &list.subscribers, &list.pending })
+                {
+                    for (EventSubscriber& subscriber : *subscribers)
+                    {
+                        // The subscription is detached directly, since cancelling it would modify the list.
+                        EventSubscription* subscription = subscriber.subscription();
+                        if (subscription != nullptr)
+                        {
+                            subscription->m_dispatcher = nullptr;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void EventDispatcher::publish(const std::string& event_name, const std::shared_ptr<Event>& event)
+    {
+        // Nobody can have subscribed for an event name that has never been used.
+        const EventTypeId event_type = find_event_type(event_name);
+        if (event_type != no_event_type)
+        {
+            publish(event_type, event);
+        }
+    }
+
+    void EventDispatcher::publish(EventTypeId event_type, const std::shared_ptr<Event>& event)
+    {
+        // Python callbacks share a single Python object for the event.
+        PythonEventCallback::PublishScope scope(event);
+        std::size_t fan_out = dispatch(m_subscriptions, event_type, event);
+
+        if (has_subscribers(m_deferred_subscriptions, event_type))
         {
-            const auto& subscription_callbacks = event_name_subscriptions.second;
-            for (const auto& subscription_callback : subscription_callbacks)
+            if (m_queue == nullptr)
             {
-                EventSubscription* subscription = subscription_callback.first;
-                subscription->unsubscribe();
+                // Without an event queue there is nothing to defer delivery until.
+                fan_out += dispatch(m_deferred_subscriptions, event_type, event);
             }
+            else
+            {
+                if (event_type >= m_queued.size())
+                {
+                    m_queued.resize(event_type + 1);
+                }
+
+                std::vector<std::shared_ptr<Event>>& queued = m_queued[event_type];
+                const EventCoalescing coalescing = queued.empty() ? EventCoalescing::None : EventDispatcher::coalescing(event_type);
+                switch (coalescing)
+                {
+                    case EventCoalescing::None:
+                        queued.push_back(event);
+                        break;
+                    case EventCoalescing::KeepFirst:
+                        break;
+                    case EventCoalescing::KeepLast:
+                        queued.back() = event;
+                        break;
+                    case EventCoalescing::Merge:
+                    {
+                        // A null event must never be queued, so the published event is kept if the merge fails.
+                        std::shared_ptr<Event> merged = coalescing_policy(event_type).merge(queued.back(), event);
+                        assert(merged != nullptr);
+                        queued.back() = merged != nullptr ? std::move(merged) : event;
+                        break;
+                    }
+                }
+
+                if (!m_scheduled)
+                {
+                    m_scheduled = true;
+                    m_queue->schedule(this);
+                }
+            }
+        }
+
+#ifdef SUBORBITAL_EVENT_STATISTICS
+        EventStatistics::record_publish(event_type, fan_out);
+#endif
+    }
+
+    std::unique_ptr<EventSubscription> EventDispatcher::subscribe(const std::string& event_name, std::unique_ptr<EventCallbackBase> callback,
+            EventDelivery delivery)
+    {
+        return subscribe(event_type(event_name), std::move(callback), delivery);
+    }
+
+    std::unique_ptr<EventSubscription> EventDispatcher::subscribe(EventTypeId event_type, std::unique_ptr<EventCallbackBase> callback,
+            EventDelivery delivery)
+    {
+        const bool scripted = callback->scripted();
+        std::unique_ptr<EventSubscription> subscription;
+        if (delivery == EventDelivery::Batched)
+        {
+            BatchCallbackAdapter adapter = { std::move(callback) };
+            subscription = subscribe(event_type, EventSubscriber(std::move(adapter)), delivery);
         }
+        else
+        {
+            CallbackAdapter adapter = { std::move(callback) };
+            subscription = subscribe(event_type, EventSubscriber(std::move(adapter)), delivery);
+        }
+
+        subscription->m_scripted = scripted;
+        return subscription;
+    }
+
+    EventTypeId EventDispatcher::event_type(const std::string& event_name)
+    {
+        auto& types = event_types();
+        return types.insert(std::make_pair(event_name, types.size())).first->second;
+    }
+
+    EventTypeId EventDispatcher::find_event_type(const std::string& event_name)
+    {
+        const auto& types = event_types();
+        auto position = types.find(event_name);
+        return position != types.end() ? position->second : no_event_type;
     }
 
-    void EventDispatcher::publish(const std::string& event_name, std::shared_ptr<Event> event)
+    std::string EventDispatcher::event_name(EventTypeId event_type)
     {
-        auto iter = m_subscriptions.find(event_name);
-        if (iter != m_subscriptions.end())
+        for (const auto& type : event_types())
         {
-            for (auto& subscription_callback : iter->second)
+            if (type.second == event_type)
             {
-                (*subscription_callback.second)(event);
+                return type.first;
             }
         }
+
+        return std::string();
+    }
+
+    void EventDispatcher::coalesce(EventTypeId event_type, EventCoalescing coalescing)
+    {
+        assert(coalescing != EventCoalescing::Merge);
+        Coalescing& policy = coalescing_policy(event_type);
+        policy.policy = coalescing;
+        policy.merge = EventMerge();
+    }
+
+    void EventDispatcher::coalesce(EventTypeId event_type, const EventMerge& merge)
+    {
+        Coalescing& policy = coalescing_policy(event_type);
+        policy.policy = merge ? EventCoalescing::Merge : EventCoalescing::None;
+        policy.merge = merge;
     }
 
-    std::unique_ptr<EventSubscription> EventDispatcher::subscribe(const std::string& event_name, std::unique_ptr<EventCallbackBase> callback)
+    EventCoalescing EventDispatcher::coalescing(EventTypeId event_type)
     {
-        EventSubscription* subscription = new EventSubscription(this, event_name);
-        auto& callbacks = m_subscriptions[event_name];
-        callbacks.insert(std::make_pair(subscription, std::move(callback)));
+        const std::vector<Coalescing>& policies = coalescing_policies();
+        return event_type < policies.size() ? policies[event_type].policy : EventCoalescing::None;
+    }
+
+    std::unique_ptr<EventSubscription> EventDispatcher::subscribe(EventTypeId event_type, EventSubscriber subscriber,
+            EventDelivery delivery)
+    {
+        std::vector<SubscriberList>& lists = subscriber_lists(delivery);
+        if (event_type >= lists.size())
+        {
+            lists.resize(event_type + 1);
+        }
+
+        const bool first = !has_subscribers(event_type);
+        EventSubscription* subscription = new EventSubscription(this, event_type, delivery);
+        subscriber.subscription(subscription);
+
+        // Subscribers are not added to the list whilst it may be being iterated over, since adding them could move the
+        // subscriber whose callback is executing. Pending subscribers are indexed as if they followed the list.
+        SubscriberList& list = lists[event_type];
+        subscription->m_index = list.subscribers.size() + list.pending.size();
+        if (m_dispatching == 0)
+        {
+            list.subscribers.push_back(std::move(subscriber));
+        }
+        else
+        {
+            list.pending.push_back(std::move(subscriber));
+            if (!list.dirty)
+            {
+                list.dirty = true;
+                m_dirty.push_back(std::make_pair(delivery, event_type));
+            }
+        }
+
+        if (first && m_observer != nullptr)
+        {
+            m_observer->first_subscribed(event_type);
+        }
 
         return std::unique_ptr<EventSubscription>(subscription);
     }
 
+    std::vector<EventDispatcher::SubscriberList>& EventDispatcher::subscriber_lists(EventDelivery delivery)
+    {
+        // Batched subscribers are deferred subscribers whose callbacks receive all of the queued events at once.
+        return delivery == EventDelivery::Immediate ? m_subscriptions : m_deferred_subscriptions;
+    }
+
+    std::size_t EventDispatcher::dispatch(std::vector<SubscriberList>& lists, EventTypeId event_type, const std::shared_ptr<Event>& event)
+    {
+        if (event_type >= lists.size())
+        {
+            return 0;
+        }
+
+        // The list is indexed afresh for each subscriber, since callbacks may cause the lists to be resized. The
+        // subscribers themselves do not move until dispatch has finished.
+        begin_dispatch();
+        std::size_t called = 0;
+        const std::size_t count = lists[event_type].subscribers.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EventSubscriber& subscriber = lists[event_type].subscribers[i];
+            if (subscriber.subscription() != nullptr)
+            {
+                call(subscriber, event_type, event);
+                ++called;
+            }
+        }
+
+        end_dispatch();
+        return called;
+    }
+
+    void EventDispatcher::call(EventSubscriber& subscriber, EventTypeId event_type, const std::shared_ptr<Event>& event)
+    {
+#ifdef SUBORBITAL_EVENT_STATISTICS
+        // The subscription is read beforehand, since the callback may cancel it.
+        const bool scripted = subscriber.subscription()->scripted();
+        const auto start = std::chrono::steady_clock::now();
+        subscriber(event);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        EventStatistics::record_callback(event_type, scripted, elapsed.count());
+#else
+        subscriber(event);
+#endif
+    }
+
+    void EventDispatcher::call(EventSubscriber& subscriber, EventTypeId event_type, const std::vector<std::shared_ptr<Event>>& events)
+    {
+#ifdef SUBORBITAL_EVENT_STATISTICS
+        const bool scripted = subscriber.subscription()->scripted();
+        const auto start = std::chrono::steady_clock::now();
+        subscriber(events);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        EventStatistics::record_callback(event_type, scripted, elapsed.count());
+#else
+        subscriber(events);
+#endif
+    }
+
+    void EventDispatcher::begin_dispatch()
+    {
+        ++m_dispatching;
+    }
+
+    void EventDispatcher::end_dispatch()
+    {
+        assert(m_dispatching > 0);
+        if (--m_dispatching > 0)
+        {
+            return;
+        }
+
+        // The callbacks of the subscriptions that were cancelled during dispatch are destroyed once the lists are
+        // consistent, since destroying them may cancel further subscriptions.
+        std::vector<EventSubscriber> cancelled;
+        for (const auto& dirty : m_dirty)
+        {
+            SubscriberList& list = subscriber_lists(dirty.first)[dirty.second];
+            for (EventSubscriber& subscriber : list.pending)
+            {
+                list.subscribers.push_back(std::move(subscriber));
+            }
+
+            for (EventSubscriber& subscriber : list.subscribers)
+            {
+                if (subscriber.subscription() == nullptr && !subscriber.empty())
+                {
+                    cancelled.push_back(std::move(subscriber));
+                }
+            }
+
+            list.pending.clear();
+            list.dirty = false;
+            compact(list);
+        }
+
+        m_dirty.clear();
+    }
+
+    void EventDispatcher::compact(SubscriberList& list)
+    {
+        if (list.tombstones == 0 || list.tombstones * 2 < list.subscribers.size())
+        {
+            return;
+        }
+
+        // Preserve the order of the remaining subscribers, updating the indices held by their subscriptions.
+        std::size_t remaining = 0;
+        for (std::size_t i = 0; i < list.subscribers.size(); ++i)
+        {
+            EventSubscription* subscription = list.subscribers[i].subscription();
+            if (subscription != nullptr)
+            {
+                if (i != remaining)
+                {
+                    list.subscribers[remaining] = std::move(list.subscribers[i]);
+                }
+
+                subscription->m_index = remaining++;
+            }
+        }
+
+        list.subscribers.erase(list.subscribers.begin() + remaining, list.subscribers.end());
+        list.tombstones = 0;
+    }
+
+    bool EventDispatcher::has_subscribers(const std::vector<SubscriberList>& lists, EventTypeId event_type)
+    {
+        if (event_type >= lists.size())
+        {
+            return false;
+        }
+
+        const SubscriberList& list = lists[event_type];
+        return list.subscribers.size() + list.pending.size() > list.tombstones;
+    }
+
+    bool EventDispatcher::has_subscribers(EventTypeId event_type) const
+    {
+        return has_subscribers(m_subscriptions, event_type) || has_subscribers(m_deferred_subscriptions, event_type);
+    }
+
     void EventDispatcher::unsubscribe(EventSubscription* subscription)
     {
         assert(subscription->active() == true);
 
-        auto iter = m_subscriptions.find(subscription->m_event_name);
-        assert (iter != m_subscriptions.end());
+        std::vector<SubscriberList>& lists = subscriber_lists(subscription->m_delivery);
+        assert(subscription->m_event_type < lists.size());
+
+        SubscriberList& list = lists[subscription->m_event_type];
+        const std::size_t index = subscription->m_index;
+        EventSubscriber& subscriber = index < list.subscribers.size()
+                ? list.subscribers[index] : list.pending[index - list.subscribers.size()];
+        assert(subscriber.subscription() == subscription);
+
+        // The subscriber is left in place as a tombstone, since its callback may be executing. Outside of dispatch, the
+        // callback is destroyed on return, once the lists are consistent.
+        subscriber.subscription(nullptr);
+        ++list.tombstones;
+
+        EventSubscriber cancelled;
+        if (m_dispatching == 0)
+        {
+            cancelled = std::move(subscriber);
+            compact(list);
+        }
+        else if (!list.dirty)
+        {
+            list.dirty = true;
+            m_dirty.push_back(std::make_pair(subscription->m_delivery, subscription->m_event_type));
+        }
+
+        if (m_observer != nullptr && !has_subscribers(subscription->m_event_type))
+        {
+            m_observer->last_unsubscribed(subscription->m_event_type);
+        }
+    }
+
+    void EventDispatcher::deliver()
+    {
+        // Events published by the subscribers during delivery are queued for the next delivery.
+        m_scheduled = false;
+        m_delivering.swap(m_queued);
+
+        begin_dispatch();
+        for (EventTypeId event_type = 0; event_type < m_delivering.size(); ++event_type)
+        {
+            std::vector<std::shared_ptr<Event>>& events = m_delivering[event_type];
+            if (events.empty())
+            {
+                continue;
+            }
+
+            // All of the events of one type are delivered to each subscriber in turn. Subscribers that are cancelled
+            // part way through receive no further events. Batched subscribers receive the events in a single call.
+            const std::size_t count = m_deferred_subscriptions[event_type].subscribers.size();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                EventSubscriber& subscriber = m_deferred_subscriptions[event_type].subscribers[i];
+                if (subscriber.batched())
+                {
+                    if (subscriber.subscription() != nullptr)
+                    {
+                        call(subscriber, event_type, events);
+                    }
+
+                    continue;
+                }
+
+                for (std::size_t j = 0; j < events.size() && subscriber.subscription() != nullptr; ++j)
+                {
+                    call(subscriber, event_type, events[j]);
+                }
+            }
+
+            // Clearing retains the capacity of the queue for the following frames.
+            events.clear();
+        }
 
-        std::size_t removed = iter->second.erase(subscription);
-        assert(removed == 1);
+        end_dispatch();
     }
 }
\ No newline at end of file
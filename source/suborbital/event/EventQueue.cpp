@@ -0,0 +1,42 @@
+#include <suborbital/event/EventQueue.hpp>
+#include <suborbital/event/EventDispatcher.hpp>
+
+namespace suborbital
+{
+    EventQueue::EventQueue()
+    : m_scheduled()
+    , m_delivering()
+    {
+        // Nothing to do.
+    }
+
+    EventQueue::~EventQueue()
+    {
+        // Nothing to do.
+    }
+
+    void EventQueue::schedule(EventDispatcher* dispatcher)
+    {
+        m_scheduled.push_back(WatchPtr<EventDispatcher>(dispatcher));
+    }
+
+    void EventQueue::deliver()
+    {
+        m_delivering.swap(m_scheduled);
+
+        for (const WatchPtr<EventDispatcher>& dispatcher : m_delivering)
+        {
+            if (dispatcher)
+            {
+                dispatcher->deliver();
+            }
+        }
+
+        m_delivering.clear();
+    }
+
+    bool EventQueue::empty() const
+    {
+        return m_scheduled.empty();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <algorithm>
+
+#include <suborbital/event/EventDispatcher.hpp>
+#include <suborbital/event/EventStatistics.hpp>
+
+namespace suborbital
+{
+    namespace
+    {
+        /**
+         * Recorded statistics, indexed by event type identifier.
+         */
+        std::vector<EventTypeStatistics>& entries()
+        {
+            static std::vector<EventTypeStatistics> statistics;
+            return statistics;
+        }
+
+        /**
+         * Statistics with all values set to zero.
+         */
+        EventTypeStatistics none()
+        {
+            EventTypeStatistics statistics = { 0, 0, 0, 0, { 0, 0.0, 0.0 }, { 0, 0.0, 0.0 } };
+            return statistics;
+        }
+
+        /**
+         * Total number of callbacks recorded in the specified `statistics`.
+         */
+        std::size_t calls(const EventTypeStatistics& statistics)
+        {
+            return statistics.cpp.calls + statistics.python.calls;
+        }
+    }
+
+    const std::size_t EventStatistics::npos = static_cast<std::size_t>(-1);
+
+    EventStatistics::Broadcast::Broadcast(EventTypeId event_type)
+    : m_event_type(event_type)
+    , m_calls(npos)
+    , m_previous(current_broadcast())
+    {
+        if (m_previous == nullptr || m_previous->m_event_type != event_type)
+        {
+            m_calls = calls(entry(event_type));
+        }
+
+        current_broadcast() = this;
+    }
+
+    EventStatistics::Broadcast::~Broadcast()
+    {
+        current_broadcast() = m_previous;
+
+        if (m_calls != npos)
+        {
+            EventTypeStatistics& statistics = entry(m_event_type);
+            ++statistics.broadcasts;
+            statistics.maximum_broadcast_fan_out = std::max(statistics.maximum_broadcast_fan_out,
+                    calls(statistics) - m_calls);
+        }
+    }
+
+    bool EventStatistics::enabled()
+    {
+#ifdef SUBORBITAL_EVENT_STATISTICS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    EventTypeStatistics EventStatistics::statistics(const std::string& event_name)
+    {
+        const EventTypeId event_type = EventDispatcher::find_event_type(event_name);
+        const std::vector<EventTypeStatistics>& statistics = entries();
+        return event_type < statistics.size() ? statistics[event_type] : none();
+    }
+
+    std::vector<std::string> EventStatistics::event_names()
+    {
+        // Entries are added for each event type up to the highest that has been recorded, so some may be empty.
+        std::vector<std::string> names;
+        const std::vector<EventTypeStatistics>& statistics = entries();
+        for (EventTypeId event_type = 0; event_type < statistics.size(); ++event_type)
+        {
+            if (statistics[event_type].publishes > 0 || calls(statistics[event_type]) > 0)
+            {
+                names.push_back(EventDispatcher::event_name(event_type));
+            }
+        }
+
+        return names;
+    }
+
+    void EventStatistics::reset()
+    {
+        // Broadcasts in progress continue to count from zero.
+        std::fill(entries().begin(), entries().end(), none());
+        for (Broadcast* broadcast = current_broadcast(); broadcast != nullptr; broadcast = broadcast->m_previous)
+        {
+            if (broadcast->m_calls != npos)
+            {
+                broadcast->m_calls = 0;
+            }
+        }
+    }
+
+    void EventStatistics::record_publish(EventTypeId event_type, std::size_t fan_out)
+    {
+        EventTypeStatistics& statistics = entry(event_type);
+        ++statistics.publishes;
+        statistics.maximum_fan_out = std::max(statistics.maximum_fan_out, fan_out);
+    }
+
+    void EventStatistics::record_callback(EventTypeId event_type, bool scripted, double seconds)
+    {
+        EventTypeStatistics& statistics = entry(event_type);
+        CallbackStatistics& callbacks = scripted ? statistics.python : statistics.cpp;
+        ++callbacks.calls;
+        callbacks.total_time += seconds;
+        callbacks.maximum_time = std::max(callbacks.maximum_time, seconds);
+    }
+
+    EventTypeStatistics& EventStatistics::entry(EventTypeId event_type)
+    {
+        std::vector<EventTypeStatistics>& statistics = entries();
+        if (event_type >= statistics.size())
+        {
+            statistics.resize(event_type + 1, none());
+        }
+
+        return statistics[event_type];
+    }
+
+    EventStatistics::Broadcast*& EventStatistics::current_broadcast()
+    {
+        static Broadcast* broadcast = nullptr;
+        return broadcast;
+    }
+}
\ No newline at end of file
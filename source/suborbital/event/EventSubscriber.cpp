@@ -0,0 +1,71 @@
+#include <suborbital/event/EventSubscriber.hpp>
+
+namespace suborbital
+{
+    EventSubscriber::EventSubscriber() noexcept
+    : m_operations(nullptr)
+    , m_subscription(nullptr)
+    {
+        // Nothing to do.
+    }
+
+    EventSubscriber::EventSubscriber(EventSubscriber&& other) noexcept
+    : m_operations(other.m_operations)
+    , m_subscription(other.m_subscription)
+    {
+        if (m_operations != nullptr)
+        {
+            m_operations->move(&other.m_storage, &m_storage);
+            other.m_operations = nullptr;
+        }
+    }
+
+    EventSubscriber& EventSubscriber::operator=(EventSubscriber&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_operations != nullptr)
+            {
+                m_operations->destroy(&m_storage);
+            }
+
+            m_operations = other.m_operations;
+            m_subscription = other.m_subscription;
+            if (m_operations != nullptr)
+            {
+                m_operations->move(&other.m_storage, &m_storage);
+                other.m_operations = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    EventSubscriber::~EventSubscriber()
+    {
+        if (m_operations != nullptr)
+        {
+            m_operations->destroy(&m_storage);
+        }
+    }
+
+    bool EventSubscriber::empty() const
+    {
+        return m_operations == nullptr;
+    }
+
+    bool EventSubscriber::batched() const
+    {
+        return m_operations != nullptr && m_operations->invoke_batch != nullptr;
+    }
+
+    EventSubscription* EventSubscriber::subscription() const
+    {
+        return m_subscription;
+    }
+
+    void EventSubscriber::subscription(EventSubscription* subscription)
+    {
+        m_subscription = subscription;
+    }
+}
\ No newline at end of file
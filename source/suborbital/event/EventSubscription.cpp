@@ -5,16 +5,23 @@
 
 namespace suborbital
 {
-    EventSubscription::EventSubscription(EventDispatcher* dispatcher, const std::string& event_name)
+    EventSubscription::EventSubscription(EventDispatcher* dispatcher, EventTypeId event_type, EventDelivery delivery)
     : m_dispatcher(dispatcher)
-    , m_event_name(event_name)
+    , m_event_type(event_type)
+    , m_delivery(delivery)
+    , m_index(0)
+    , m_scripted(false)
     {
         // Nothing to do.
     }
 
     EventSubscription::~EventSubscription()
     {
-        unsubscribe();
+        // The subscription may already have been cancelled manually, or by the destruction of the dispatcher.
+        if (active())
+        {
+            unsubscribe();
+        }
     }
 
     bool EventSubscription::active() const
@@ -22,6 +29,11 @@ namespace suborbital
         return m_dispatcher != nullptr;
     }
 
+    bool EventSubscription::scripted() const
+    {
+        return m_scripted;
+    }
+
     void EventSubscription::unsubscribe()
     {
         assert(m_dispatcher != nullptr);
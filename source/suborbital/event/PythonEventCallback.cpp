@@ -4,6 +4,62 @@
 
 namespace suborbital
 {
+    namespace
+    {
+        /**
+         * Accessor for the SWIG type information for event shared pointers.
+         *
+         * The type information is looked up the first time that it is requested and is cached thereafter.
+         */
+        swig_type_info* event_type_info()
+        {
+            static swig_type_info* const type_info = SWIG_TypeQuery("std::shared_ptr<suborbital::Event>*");
+            assert(type_info != NULL);
+            return type_info;
+        }
+    }
+
+    PythonEventCallback::PublishScope::PublishScope(const std::shared_ptr<Event>& event)
+    : m_event(event)
+    , m_object(nullptr)
+    , m_previous(current())
+    , m_active(find(event.get()) == nullptr)
+    {
+        if (m_active)
+        {
+            current() = this;
+        }
+    }
+
+    PythonEventCallback::PublishScope::~PublishScope()
+    {
+        if (m_active)
+        {
+            assert(current() == this);
+            current() = m_previous;
+            Py_XDECREF(m_object);
+        }
+    }
+
+    PythonEventCallback::PublishScope* PythonEventCallback::PublishScope::find(const Event* event)
+    {
+        for (PublishScope* scope = current(); scope != nullptr; scope = scope->m_previous)
+        {
+            if (scope->m_event.get() == event)
+            {
+                return scope;
+            }
+        }
+
+        return nullptr;
+    }
+
+    PythonEventCallback::PublishScope*& PythonEventCallback::PublishScope::current()
+    {
+        static PublishScope* scope = nullptr;
+        return scope;
+    }
+
     PythonEventCallback::PythonEventCallback(PyObject* callback_function)
     : EventCallbackBase()
     , m_callback_function(callback_function)
@@ -39,21 +95,67 @@ namespace suborbital
         return *this;
     }
 
-    void PythonEventCallback::operator()(std::shared_ptr<Event> event)
+    bool PythonEventCallback::scripted() const
     {
-        std::shared_ptr<PythonEvent> python_event = std::dynamic_pointer_cast<PythonEvent>(event);
-        if (python_event)
+        return true;
+    }
+
+    void PythonEventCallback::operator()(const std::shared_ptr<Event>& event)
+    {
+        PyObject* python_event_object = python_object(event);
+        PyObject* result = PyObject_CallFunctionObjArgs(m_callback_function, python_event_object, NULL);
+        if (result == NULL)
+        {
+            PyErr_Print();
+        }
+
+        Py_XDECREF(result);
+        Py_DECREF(python_event_object);
+    }
+
+    void PythonEventCallback::handle_batch(const std::vector<std::shared_ptr<Event>>& events)
+    {
+        PyObject* python_events = PyList_New(static_cast<Py_ssize_t>(events.size()));
+        for (std::size_t i = 0; i < events.size(); ++i)
+        {
+            // The list steals the reference to the item.
+            PyList_SET_ITEM(python_events, static_cast<Py_ssize_t>(i), python_object(events[i]));
+        }
+
+        PyObject* result = PyObject_CallFunctionObjArgs(m_callback_function, python_events, NULL);
+        if (result == NULL)
+        {
+            PyErr_Print();
+        }
+
+        Py_XDECREF(result);
+        Py_DECREF(python_events);
+    }
+
+    PyObject* PythonEventCallback::python_object(const std::shared_ptr<Event>& event)
+    {
+        PythonEvent* python_event = dynamic_cast<PythonEvent*>(event.get());
+        if (python_event != nullptr)
         {
             PyObject* derived_instance = python_event->instance();
             assert(derived_instance != nullptr);
-            PyObject_CallFunctionObjArgs(m_callback_function, derived_instance, NULL);
+            Py_INCREF(derived_instance);
+            return derived_instance;
         }
-        else
+
+        // The callback may keep the Python object beyond the publish, so the proxy owns a copy of the shared pointer.
+        PublishScope* scope = PublishScope::find(event.get());
+        if (scope == nullptr)
         {
-            swig_type_info* event_type_info = SWIG_TypeQuery("std::shared_ptr<suborbital::Event>*");
-            assert(event_type_info != NULL);
-            PyObject* python_event_object = SWIG_NewPointerObj((void*) &event, event_type_info, 0);
-            PyObject_CallFunctionObjArgs(m_callback_function, python_event_object, NULL);
+            return SWIG_NewPointerObj(new std::shared_ptr<Event>(event), event_type_info(), SWIG_POINTER_OWN);
         }
+
+        if (scope->m_object == nullptr)
+        {
+            scope->m_object = SWIG_NewPointerObj(new std::shared_ptr<Event>(event), event_type_info(), SWIG_POINTER_OWN);
+        }
+
+        Py_INCREF(scope->m_object);
+        return scope->m_object;
     }
 }
\ No newline at end of file
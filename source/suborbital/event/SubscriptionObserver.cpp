@@ -0,0 +1,14 @@
+#include <suborbital/event/SubscriptionObserver.hpp>
+
+namespace suborbital
+{
+    SubscriptionObserver::SubscriptionObserver()
+    {
+        // Nothing to do.
+    }
+
+    SubscriptionObserver::~SubscriptionObserver()
+    {
+        // Nothing to do.
+    }
+}
\ No newline at end of file
@@ -3,15 +3,20 @@
 #include <suborbital/scene/Scene.hpp>
 
 #include <suborbital/event/EventCallbackBase.hpp>
+#include <suborbital/event/EventStatistics.hpp>
 #include <suborbital/event/EventSubscription.hpp>
+#include <suborbital/event/PythonEventCallback.hpp>
 
 namespace suborbital
 {
     Scene::Scene()
     : Watchable()
+    , m_event_queue()
     , m_entities(*this)
     , m_camera(nullptr)
-    , m_event_dispatcher(new EventDispatcher())
+    , m_event_dispatcher(new EventDispatcher(&m_event_queue))
+    , m_posted()
+    , m_publishing()
     , m_systems()
     {
         // Nothing to do.
@@ -52,27 +57,95 @@ namespace suborbital
         return m_entities.create(entity_name);
     }
 
-    void Scene::publish(const std::string& event_name, std::shared_ptr<suborbital::Event> event)
+    void Scene::publish(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event)
     {
         m_event_dispatcher->publish(event_name, event);
     }
 
-    void Scene::broadcast(const std::string& event_name, std::shared_ptr<suborbital::Event> event)
+    void Scene::broadcast(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event)
     {
-        publish(event_name, event);
+        // The event name is looked up once for the scene and all of its entities.
+        const EventTypeId event_type = EventDispatcher::find_event_type(event_name);
+        if (event_type != EventDispatcher::no_event_type)
+        {
+            broadcast_event(event_type, event);
+        }
+    }
+
+    void Scene::broadcast_event(EventTypeId event_type, const std::shared_ptr<suborbital::Event>& event)
+    {
+#ifdef SUBORBITAL_EVENT_STATISTICS
+        EventStatistics::Broadcast statistics(event_type);
+#endif
+
+        PythonEventCallback::PublishScope scope(event);
 
-        const EntitySet& entities = m_entities.all();
-        for (auto iter = entities.cbegin(); iter != entities.cend(); ++iter)
+        m_event_dispatcher->publish(event_type, event);
+
+        // Only the entities that have subscribers for the event type are visited. Entities that subscribe during the
+        // broadcast do not receive the event.
+        const EntityView entities = m_entities.subscribers(event_type);
+        for (auto iter = entities.cbegin(), end = entities.cend(); iter != end; ++iter)
         {
             const WatchPtr<Entity>& entity = *iter;
-            entity->broadcast(event_name, event);
+            if (entity->alive())
+            {
+                entity->m_event_dispatcher->publish(event_type, event);
+            }
         }
     }
 
+    void Scene::post(const std::string& event_name, const std::shared_ptr<suborbital::Event>& event)
+    {
+        post(EntityHandle(), event_name, event);
+    }
+
+    void Scene::post(EntityHandle handle, const std::string& event_name, const std::shared_ptr<suborbital::Event>& event)
+    {
+        ConcurrentEventQueue::Post post = { handle, nullptr, event_name, event };
+        m_posted.push(std::move(post));
+    }
+
+    void Scene::post(EntityHandle handle, EventTypeId (*event_type)(), const std::shared_ptr<suborbital::Event>& event)
+    {
+        ConcurrentEventQueue::Post post = { handle, event_type, std::string(), event };
+        m_posted.push(std::move(post));
+    }
+
+    void Scene::publish_posted()
+    {
+        m_posted.drain(m_publishing);
+        for (ConcurrentEventQueue::Post& post : m_publishing)
+        {
+            const EventTypeId event_type = post.event_type != nullptr
+                    ? post.event_type() : EventDispatcher::find_event_type(post.event_name);
+            if (event_type == EventDispatcher::no_event_type)
+            {
+                continue;
+            }
+
+            if (post.entity)
+            {
+                // Entities without a dispatcher have never had any subscribers.
+                Entity* entity = m_entities.get(post.entity);
+                if (entity != nullptr && entity->alive() && entity->m_event_dispatcher != nullptr)
+                {
+                    entity->m_event_dispatcher->publish(event_type, post.event);
+                }
+            }
+            else
+            {
+                m_event_dispatcher->publish(event_type, post.event);
+            }
+        }
+
+        m_publishing.clear();
+    }
+
     std::unique_ptr<suborbital::EventSubscription> Scene::subscribe(const std::string& event_name,
-            std::unique_ptr<suborbital::EventCallbackBase> callback)
+            std::unique_ptr<suborbital::EventCallbackBase> callback, EventDelivery delivery)
     {
-        return m_event_dispatcher->subscribe(event_name, std::move(callback));
+        return m_event_dispatcher->subscribe(event_name, std::move(callback), delivery);
     }
 
     WatchPtr<System> Scene::create_system(const std::string& class_name)
@@ -102,27 +175,28 @@ namespace suborbital
 
     void Scene::process(double dt)
     {
-        // 1. Call the scene's update function.
+        // 1. Publish the events posted since the previous frame.
+        publish_posted();
+
+        // 2. Call the scene's update function.
         update(dt);
 
-        // 2. Process all of the systems.
+        // 3. Process all of the systems.
         for (const auto& kv : m_systems)
         {
             kv.second->process(dt);
         }
 
-        // 3. Update all of the alive entities in the scene.
-        const EntitySet& entities = m_entities.all();
-        for (auto iter = entities.cbegin(); iter != entities.cend(); ++iter)
-        {
-            const WatchPtr<Entity>& entity = *iter;
-            if (entity->alive())
-            {
-                entity->update(dt);
-            }
-        }
+        // 4. Update all of the alive entities in the scene.
+        m_entities.update(dt);
+
+        // 5. Deliver the deferred events.
+        m_event_queue.deliver();
+
+        // 6. Apply the structural changes recorded in command buffers.
+        m_entities.execute();
 
-        // 4. Delete all entities marked for destruction.
+        // 7. Delete all entities marked for destruction.
         m_entities.purge();
     }
 }
\ No newline at end of file
@@ -23,6 +23,12 @@
         return $action(self)
 %}
 
+%feature("shadow") suborbital::Entity::handle %{
+    @property
+    def handle(self):
+        return $action(self)
+%}
+
 %feature("shadow") suborbital::Entity::dead %{
     @property
     def dead(self):
@@ -160,40 +166,46 @@
 
 // Manually define the Python wrapper function for Entity::subscribe so that we convert the callback function from a
 // strongly bound method to weakly bound method, using the WeaklyBoundMethod class defined above.
-%feature("shadow") suborbital::Entity::subscribe(const std::string&, PyObject*) %{
-    def subscribe(self, event, strongly_bound_method):
+// The delivery mode defaults to immediate delivery. Subscribing with EventDelivery_Batched delivers a list of all of
+// the events of the type that were queued during the frame in a single call.
+%feature("shadow") suborbital::Entity::subscribe(const std::string&, PyObject*, suborbital::EventDelivery) %{
+    def subscribe(self, event, strongly_bound_method, delivery=None):
+        if delivery is None:
+            delivery = EventDelivery_Immediate
         if isinstance(event, str):
-            return $action(self, event, WeaklyBoundMethod(strongly_bound_method))
+            return $action(self, event, WeaklyBoundMethod(strongly_bound_method), delivery)
         else:
-            return $action(self, event.__name__, WeaklyBoundMethod(strongly_bound_method))
+            return $action(self, event.__name__, WeaklyBoundMethod(strongly_bound_method), delivery)
 %}
 
 // Ignore the Entity::subscribe function. An alternative implementation is provided below that SWIG is able to work
 // with.
-%ignore suborbital::Entity::subscribe(const std::string&, std::unique_ptr<suborbital::EventCallbackBase>);
+%ignore suborbital::Entity::subscribe(const std::string&, std::unique_ptr<suborbital::EventCallbackBase>, suborbital::EventDelivery);
 
 // The scripting language should take ownership of the EventSubscription pointer that is returned by our SWIG specific
 // implementation of the Entity::subscribe function.
-%newobject suborbital::Entity::subscribe(const std::string&, PyObject*);
+%newobject suborbital::Entity::subscribe(const std::string&, PyObject*, suborbital::EventDelivery);
 
 // SWIG doesn't have any support for std::unique_ptr, so we need to provide an alternative implementation for the
 // Entity::subscribe function that returns a raw pointer instead. Note (as above) that the returned pointer should be
 // managed by the scripting language's garbage collector.
 %extend suborbital::Entity
 {
-    suborbital::EventSubscription* suborbital::Entity::subscribe(const std::string& event_name, PyObject* callback)
+    suborbital::EventSubscription* suborbital::Entity::subscribe(const std::string& event_name, PyObject* callback,
+            suborbital::EventDelivery delivery)
     {
         std::unique_ptr<suborbital::EventCallbackBase> callback_wrapper(new suborbital::PythonEventCallback(callback));
-        std::unique_ptr<suborbital::EventSubscription> subscription = $self->subscribe(event_name, std::move(callback_wrapper));
+        std::unique_ptr<suborbital::EventSubscription> subscription = $self->subscribe(event_name, std::move(callback_wrapper),
+                delivery);
         return subscription.release();
     }
 }
 
 // Ignore the Entity::publish, Entity::broadcast_descendents and Entity::broadcast functions. Alternative
 // implementations of these functions are provided below.
-%ignore suborbital::Entity::publish(const std::string&, std::shared_ptr<suborbital::Event>);
-%ignore suborbital::Entity::broadcast_descendents(const std::string&, std::shared_ptr<suborbital::Event>);
-%ignore suborbital::Entity::broadcast(const std::string&, std::shared_ptr<suborbital::Event>);
+%ignore suborbital::Entity::publish(const std::string&, const std::shared_ptr<suborbital::Event>&);
+%ignore suborbital::Entity::broadcast_descendents(const std::string&, const std::shared_ptr<suborbital::Event>&);
+%ignore suborbital::Entity::broadcast(const std::string&, const std::shared_ptr<suborbital::Event>&);
 
 // Our alternative implementation of the Entity::publish function stores the PyObject* for the derived event inside of
 // the PythonEvent instance. This allows us to pass the PyObject* to the Python callback function, thus preserving type
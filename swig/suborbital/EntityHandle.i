@@ -0,0 +1,37 @@
+%{
+    #include <suborbital/EntityHandle.hpp>
+%}
+
+%include <stdint.i>
+
+// Rewrite getter methods to use Python properties.
+%feature("shadow") suborbital::EntityHandle::index %{
+    @property
+    def index(self):
+        return $action(self)
+%}
+
+%feature("shadow") suborbital::EntityHandle::generation %{
+    @property
+    def generation(self):
+        return $action(self)
+%}
+
+%feature("shadow") suborbital::EntityHandle::value %{
+    @property
+    def value(self):
+        return $action(self)
+%}
+
+// Allow handles to be used as keys in Python dictionaries and sets.
+%extend suborbital::EntityHandle
+{
+    std::size_t __hash__() const
+    {
+        return std::hash<suborbital::EntityHandle>()(*$self);
+    }
+}
+
+%ignore suborbital::EntityHandle::operator bool;
+
+%include <suborbital/EntityHandle.hpp>
\ No newline at end of file
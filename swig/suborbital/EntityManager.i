@@ -2,10 +2,26 @@
     #include <suborbital/EntityManager.hpp>
 %}
 
+// Allow Python lists of strings to be passed as class names.
+%template(StringVector) std::vector<std::string>;
+
 %feature("shadow") suborbital::EntityManager::all %{
     @property
     def all(self):
         return $action(self)
 %}
 
+// Custom implementation for the Python method that calls the `query` function. This method takes the Python types of
+// the components as its parameters and passes their names into the `query` function.
+%feature("shadow") suborbital::EntityManager::query %{
+    def query(self, *component_types):
+        return $action(self, [component_type.__name__ for component_type in component_types])
+%}
+
+// Allow the group names to be passed to `intersect_groups` as separate arguments.
+%feature("shadow") suborbital::EntityManager::intersect_groups %{
+    def intersect_groups(self, *group_names):
+        return $action(self, list(group_names))
+%}
+
 %include <suborbital/EntityManager.hpp>
\ No newline at end of file
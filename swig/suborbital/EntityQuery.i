@@ -0,0 +1,60 @@
+%{
+    #include <suborbital/EntityQuery.hpp>
+%}
+
+// Rewrite getter methods to use Python properties.
+%feature("shadow") suborbital::EntityQuery::size %{
+    @property
+    def size(self):
+        return $action(self)
+%}
+
+%feature("shadow") suborbital::EntityQuery::empty %{
+    @property
+    def empty(self):
+        return $action(self)
+%}
+
+// The query's iterators are not exposed to Python. Python code should iterate over the query directly.
+%ignore suborbital::EntityQuery::const_iterator;
+%ignore suborbital::EntityQuery::signature;
+%ignore suborbital::EntityQuery::begin;
+%ignore suborbital::EntityQuery::end;
+
+// Python iteration over queries works in the same way as for entity sets. Note that the Python iterator object holds
+// an iteration lock on the component storage until it is garbage collected.
+
+%inline %{
+    struct EntityQueryIterator {
+        suborbital::EntityQuery::const_iterator current;
+        suborbital::EntityQuery::const_iterator end;
+    };
+%}
+
+%exception EntityQueryIterator::next {
+    if (arg1->current == arg1->end) {
+        SWIG_SetErrorObj(PyExc_StopIteration, SWIG_Py_Void());
+        SWIG_fail;
+    } else {
+        $action;
+    }
+}
+
+%extend EntityQueryIterator {
+    EntityQueryIterator* __iter__() {
+        return $self;
+    }
+
+    suborbital::WatchPtr<suborbital::Entity> next() {
+        return suborbital::WatchPtr<suborbital::Entity>(*($self->current++));
+    }
+}
+
+%extend suborbital::EntityQuery {
+    EntityQueryIterator __iter__() {
+        EntityQueryIterator iter = { $self->begin(), $self->end() };
+        return iter;
+    }
+}
+
+%include <suborbital/EntityQuery.hpp>
\ No newline at end of file
@@ -15,21 +15,15 @@
         return $action(self)
 %}
 
-%feature("shadow") suborbital::EntitySet::begin %{
-    @property
-    def begin(self):
-        return $action(self)
-%}
-
-%feature("shadow") suborbital::EntitySet::end %{
-    @property
-    def end(self):
-        return $action(self)
-%}
-
-// Include std::set so that the set iterators are exposed to SWIG.
-%include <std_set.i>
-%template(InternalEntitySet) std::set<suborbital::WatchPtr<suborbital::Entity>>;
+// The set's iterators are not exposed to Python. Python code should iterate over the set directly and use `in` to
+// test for membership.
+%ignore suborbital::EntitySet::const_iterator;
+%ignore suborbital::EntitySet::find;
+%ignore suborbital::EntitySet::remove(const_iterator);
+%ignore suborbital::EntitySet::begin;
+%ignore suborbital::EntitySet::cbegin;
+%ignore suborbital::EntitySet::end;
+%ignore suborbital::EntitySet::cend;
 
 // We need to do a little work to allow Python to iterate over entity sets. In particular, we need to provide an
 // `__iter__` method that returns an iterator object for the set. Our iterator object needs to recall the current
@@ -68,6 +62,10 @@
         EntitySetIterator iter = { $self->begin(), $self->end() };
         return iter;
     }
+
+    bool __contains__(suborbital::WatchPtr<suborbital::Entity> entity) {
+        return $self->find(entity) != $self->end();
+    }
 }
 
 %include <suborbital/EntitySet.hpp>
\ No newline at end of file
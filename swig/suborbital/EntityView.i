@@ -0,0 +1,67 @@
+%{
+    #include <suborbital/EntityView.hpp>
+%}
+
+// Rewrite getter methods to use Python properties.
+%feature("shadow") suborbital::EntityView::size %{
+    @property
+    def size(self):
+        return $action(self)
+%}
+
+%feature("shadow") suborbital::EntityView::empty %{
+    @property
+    def empty(self):
+        return $action(self)
+%}
+
+// The view's iterators are not exposed to Python. Python code should iterate over the view directly and use `in` to
+// test for membership.
+%ignore suborbital::EntityView::const_iterator;
+%ignore suborbital::EntityView::contains;
+%ignore suborbital::EntityView::begin;
+%ignore suborbital::EntityView::cbegin;
+%ignore suborbital::EntityView::end;
+%ignore suborbital::EntityView::cend;
+
+// Python iteration over entity views works in the same way as for entity sets. Note that the Python iterator object
+// holds an iteration lock on the viewed set until it is garbage collected.
+
+%inline %{
+    struct EntityViewIterator {
+        suborbital::EntityView::const_iterator current;
+        suborbital::EntityView::const_iterator end;
+    };
+%}
+
+%exception EntityViewIterator::next {
+    if (arg1->current == arg1->end) {
+        SWIG_SetErrorObj(PyExc_StopIteration, SWIG_Py_Void());
+        SWIG_fail;
+    } else {
+        $action;
+    }
+}
+
+%extend EntityViewIterator {
+    EntityViewIterator* __iter__() {
+        return $self;
+    }
+
+    suborbital::WatchPtr<suborbital::Entity> next() {
+        return *($self->current++);
+    }
+}
+
+%extend suborbital::EntityView {
+    EntityViewIterator __iter__() {
+        EntityViewIterator iter = { $self->begin(), $self->end() };
+        return iter;
+    }
+
+    bool __contains__(suborbital::WatchPtr<suborbital::Entity> entity) {
+        return $self->contains(entity);
+    }
+}
+
+%include <suborbital/EntityView.hpp>
\ No newline at end of file
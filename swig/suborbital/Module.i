@@ -30,6 +30,7 @@ class WeaklyBoundMethod:
 // Include parts of the c++ standard library.
 %include <std_string.i>
 %include <std_shared_ptr.i>
+%include <std_vector.i>
 
 // Specify which classes should be wrapped using std::shared_ptr.
 // Note that this must be done before before any usage or declaration of the classes.
@@ -39,8 +40,11 @@ class WeaklyBoundMethod:
 // Include classes.
 %include <suborbital/Watchable.i>
 %include <suborbital/WatchPtr.i>
+%include <suborbital/EntityHandle.i>
 %include <suborbital/Entity.i>
 %include <suborbital/EntitySet.i>
+%include <suborbital/EntityView.i>
+%include <suborbital/EntityQuery.i>
 %include <suborbital/EntityManager.i>
 
 %include <suborbital/scene/Scene.i>
@@ -58,6 +62,7 @@ class WeaklyBoundMethod:
 %include <suborbital/event/Event.i>
 %include <suborbital/event/PythonEvent.i>
 %include <suborbital/event/EventSubscription.i>
+%include <suborbital/event/EventStatistics.i>
 %include <suborbital/event/EventCallbackBase.i>
 %include <suborbital/event/PythonEventCallback.i>
 
@@ -9,6 +9,9 @@
     #include <suborbital/Entity.hpp>
     #include <suborbital/EntityManager.hpp>
     #include <suborbital/EntitySet.hpp>
+    #include <suborbital/EntityView.hpp>
+    #include <suborbital/EntityQuery.hpp>
+    #include <suborbital/EntityHandle.hpp>
     #include <suborbital/Watchable.hpp>
     #include <suborbital/WatchPtr.hpp>
 
@@ -22,6 +25,7 @@
     #include <suborbital/event/EventCallback.hpp>
     #include <suborbital/event/EventCallbackBase.hpp>
     #include <suborbital/event/EventDispatcher.hpp>
+    #include <suborbital/event/EventStatistics.hpp>
     #include <suborbital/event/EventSubscription.hpp>
     #include <suborbital/event/PythonEvent.hpp>
     #include <suborbital/event/PythonEventCallback.hpp>
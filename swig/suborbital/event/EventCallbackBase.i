@@ -4,4 +4,7 @@
 
 %feature("director") suborbital::EventCallbackBase;
 
+// Batches of events are passed to Python callbacks by PythonEventCallback, rather than through the director.
+%ignore suborbital::EventCallbackBase::handle_batch;
+
 %include <suborbital/event/EventCallbackBase.hpp>
\ No newline at end of file
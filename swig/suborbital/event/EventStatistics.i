@@ -0,0 +1,5 @@
+%{
+    #include <suborbital/event/EventStatistics.hpp>
+%}
+
+%include <suborbital/event/EventStatistics.hpp>
\ No newline at end of file
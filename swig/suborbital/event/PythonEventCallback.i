@@ -4,4 +4,6 @@
 
 %feature("director") suborbital::PythonEventCallback;
 
+%ignore suborbital::PythonEventCallback::handle_batch;
+
 %include <suborbital/event/PythonEventCallback.hpp>
\ No newline at end of file
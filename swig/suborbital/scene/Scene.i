@@ -54,39 +54,50 @@
 
 // Manually define the Python wrapper function for Scene::subscribe so that we convert the callback function from a
 // strongly bound method to weakly bound method, using the WeaklyBoundMethod class defined above.
-%feature("shadow") suborbital::Scene::subscribe(const std::string&, PyObject*) %{
-    def subscribe(self, event, strongly_bound_method):
+// The delivery mode defaults to immediate delivery. Subscribing with EventDelivery_Batched delivers a list of all of
+// the events of the type that were queued during the frame in a single call.
+%feature("shadow") suborbital::Scene::subscribe(const std::string&, PyObject*, suborbital::EventDelivery) %{
+    def subscribe(self, event, strongly_bound_method, delivery=None):
+        if delivery is None:
+            delivery = EventDelivery_Immediate
         if isinstance(event, str):
-            return $action(self, event, WeaklyBoundMethod(strongly_bound_method))
+            return $action(self, event, WeaklyBoundMethod(strongly_bound_method), delivery)
         else:
-            return $action(self, event.__name__, WeaklyBoundMethod(strongly_bound_method))
+            return $action(self, event.__name__, WeaklyBoundMethod(strongly_bound_method), delivery)
 %}
 
 // Ignore the Scene::subscribe function. An alternative implementation is provided below that SWIG is able to work with.
-%ignore suborbital::Scene::subscribe(const std::string&, std::unique_ptr<suborbital::EventCallbackBase>);
+%ignore suborbital::Scene::subscribe(const std::string&, std::unique_ptr<suborbital::EventCallbackBase>, suborbital::EventDelivery);
 
 // The scripting language should take ownership of the EventSubscription pointer that is returned by our SWIG specific
 // implementation of the Scene::subscribe function.
-%newobject suborbital::Scene::subscribe(const std::string&, PyObject*);
+%newobject suborbital::Scene::subscribe(const std::string&, PyObject*, suborbital::EventDelivery);
 
 // SWIG doesn't have any support for std::unique_ptr, so we need to provide an alternative implementation for the
 // Scene::subscribe function that returns a raw pointer instead. Note (as above) that the returned pointer should be
 // managed by the scripting language's garbage collector.
 %extend suborbital::Scene
 {
-    suborbital::EventSubscription* suborbital::Scene::subscribe(const std::string& event_name, PyObject* callback)
+    suborbital::EventSubscription* suborbital::Scene::subscribe(const std::string& event_name, PyObject* callback,
+            suborbital::EventDelivery delivery)
     {
         std::unique_ptr<suborbital::EventCallbackBase> callback_wrapper(new suborbital::PythonEventCallback(callback));
-        std::unique_ptr<suborbital::EventSubscription> subscription = $self->subscribe(event_name, std::move(callback_wrapper));
+        std::unique_ptr<suborbital::EventSubscription> subscription = $self->subscribe(event_name, std::move(callback_wrapper),
+                delivery);
         return subscription.release();
     }
 }
 
 // Ignore the Scene::publish and Scene::broadcast functions. Alternative implementations of these functions are provided
 // below.
-%ignore suborbital::Scene::publish(const std::string&, std::shared_ptr<suborbital::Event>);
-%ignore suborbital::Scene::broadcast_descendents(const std::string&, std::shared_ptr<suborbital::Event>);
-%ignore suborbital::Scene::broadcast(const std::string&, std::shared_ptr<suborbital::Event>);
+%ignore suborbital::Scene::publish(const std::string&, const std::shared_ptr<suborbital::Event>&);
+%ignore suborbital::Scene::broadcast_descendents(const std::string&, const std::shared_ptr<suborbital::Event>&);
+%ignore suborbital::Scene::broadcast(const std::string&, const std::shared_ptr<suborbital::Event>&);
+
+// Ignore the Scene::post functions. These exist for native worker threads, and Python events must not be released
+// without holding the interpreter lock.
+%ignore suborbital::Scene::post(const std::string&, const std::shared_ptr<suborbital::Event>&);
+%ignore suborbital::Scene::post(suborbital::EntityHandle, const std::string&, const std::shared_ptr<suborbital::Event>&);
 
 // Our alternative implementation of the Scene::publish function stores the PyObject* for the derived event inside of
 // the PythonEvent instance. This allows us to pass the PyObject* to the Python callback function, thus preserving type